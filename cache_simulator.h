@@ -0,0 +1,357 @@
+#ifndef CACHE_SIMULATOR_H
+#define CACHE_SIMULATOR_H
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "clock_cache.h"
+#include "lfu_cache.h"
+#include "lru_cache.h"
+#include "tiny_lfu_cache.h"
+
+namespace xsf_data_structures {
+
+// 缓存策略的离线模拟器：读取或生成 key 的访问序列（trace），在多种容量下回放到各个缓存，
+// 统计命中率、吞吐量和每个条目占用的内存，用于在真实访问模式上比较不同的缓存策略
+// 回放时每次访问先 get，未命中时再 put，即“读穿透”的使用方式
+namespace cache_simulator {
+
+using Trace = std::vector<uint64_t>;
+
+// 一次回放的结果
+struct Result {
+  std::string policy;
+  size_t capacity{0};
+  size_t accesses{0};
+  size_t hits{0};
+  double hit_ratio{0};
+  double ops_per_sec{0};
+  // 回放结束时堆内存增量除以条目个数，包含哈希表、链表节点等开销
+  // 只在 glibc 下可用，其他平台为 0
+  double bytes_per_entry{0};
+};
+
+// 读写 trace
+
+// CSV 格式：每行一次访问，取第一列作为 key，无法解析为整数的行（如表头）被跳过
+inline Trace LoadCsvTrace(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot open trace file: " + path);
+  }
+  Trace trace;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t end = line.find(',');
+    std::string field = line.substr(0, end);
+    try {
+      trace.push_back(std::stoull(field));
+    } catch (const std::exception&) {
+      continue;
+    }
+  }
+  return trace;
+}
+
+// 二进制格式：连续存放的 uint64_t（本机字节序），没有文件头
+inline Trace LoadBinaryTrace(const std::string& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error("cannot open trace file: " + path);
+  }
+  std::streamsize bytes = in.tellg();
+  if (bytes % sizeof(uint64_t) != 0) {
+    throw std::runtime_error("binary trace size is not a multiple of 8");
+  }
+  Trace trace(static_cast<size_t>(bytes) / sizeof(uint64_t));
+  in.seekg(0);
+  if (!trace.empty() &&
+      !in.read(reinterpret_cast<char*>(trace.data()), bytes)) {
+    throw std::runtime_error("cannot read trace file: " + path);
+  }
+  return trace;
+}
+
+inline void SaveBinaryTrace(const Trace& trace, const std::string& path) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("cannot open trace file: " + path);
+  }
+  out.write(reinterpret_cast<const char*>(trace.data()),
+            static_cast<std::streamsize>(trace.size() * sizeof(uint64_t)));
+}
+
+// 生成合成的 trace
+
+// Zipf 分布：key 为 [0, key_count)，第 i 个 key 被访问的概率正比于 1 / (i + 1)^skew
+// skew 越大访问越集中在少数热点上，典型值为 0.6 ~ 1.2
+inline Trace ZipfTrace(size_t length, size_t key_count, double skew,
+                       uint64_t seed = 1) {
+  if (key_count == 0) {
+    throw std::invalid_argument("key count is zero");
+  }
+  std::vector<double> cdf(key_count);
+  double sum = 0;
+  for (size_t i = 0; i < key_count; i++) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+    cdf[i] = sum;
+  }
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> uniform(0, sum);
+  Trace trace;
+  trace.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    auto it = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng));
+    size_t key = it == cdf.end() ? key_count - 1 : it - cdf.begin();
+    trace.push_back(key);
+  }
+  return trace;
+}
+
+// 顺序扫描：first, first + 1, ...，每个 key 只访问一次，用于模拟批处理对缓存的污染
+inline Trace ScanTrace(size_t length, uint64_t first) {
+  Trace trace;
+  trace.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    trace.push_back(first + i);
+  }
+  return trace;
+}
+
+// 循环访问 [0, loop_length)，循环长度略大于容量时 LRU 的命中率为 0
+inline Trace LoopTrace(size_t length, size_t loop_length) {
+  if (loop_length == 0) {
+    throw std::invalid_argument("loop length is zero");
+  }
+  Trace trace;
+  trace.reserve(length);
+  for (size_t i = 0; i < length; i++) {
+    trace.push_back(i % loop_length);
+  }
+  return trace;
+}
+
+// 按 period 交替拼接两个 trace：先取 a 的 period 个，再取 b 的 period 个，直到两者都取完
+// 例如把 Zipf 与扫描交替，模拟热点访问中夹杂批量扫描
+inline Trace InterleaveTrace(const Trace& a, const Trace& b, size_t period) {
+  if (period == 0) {
+    throw std::invalid_argument("period is zero");
+  }
+  Trace trace;
+  trace.reserve(a.size() + b.size());
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a.size() || j < b.size()) {
+    for (size_t k = 0; k < period && i < a.size(); k++) {
+      trace.push_back(a[i++]);
+    }
+    for (size_t k = 0; k < period && j < b.size(); k++) {
+      trace.push_back(b[j++]);
+    }
+  }
+  return trace;
+}
+
+// 回放
+
+// 当前已分配的堆内存字节数，不可用时返回 0
+// uordblks 只统计 arena 中的分配，超过 mmap 阈值的大块（如哈希表的桶数组）
+// 单独用 mmap 分配，计入 hblkhd，两者都要算上
+inline size_t HeapBytes() {
+#ifdef __GLIBC__
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#else
+  struct mallinfo info = mallinfo();
+  return static_cast<size_t>(info.uordblks) + static_cast<size_t>(info.hblkhd);
+#endif
+#else
+  return 0;
+#endif
+}
+
+// 把 trace 回放到 cache 上，access(cache, key) 执行一次访问并返回是否命中
+// cache 应为新建的空缓存
+template <typename Cache, typename Access>
+Result Replay(const std::string& policy, size_t capacity, Cache& cache,
+              const Trace& trace, Access&& access, size_t heap_before) {
+  Result result;
+  result.policy = policy;
+  result.capacity = capacity;
+  result.accesses = trace.size();
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t key : trace) {
+    if (access(cache, key)) {
+      result.hits++;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - start).count();
+  if (!trace.empty()) {
+    result.hit_ratio = static_cast<double>(result.hits) / trace.size();
+  }
+  if (seconds > 0) {
+    result.ops_per_sec = trace.size() / seconds;
+  }
+  size_t heap_after = HeapBytes();
+  size_t entries = cache.size();
+  if (entries > 0 && heap_after > heap_before) {
+    result.bytes_per_entry =
+        static_cast<double>(heap_after - heap_before) / entries;
+  }
+  return result;
+}
+
+// LRUCache、LFUCache 只支持 int 类型的 key，回放前把 trace 中的 key 按首次出现的顺序
+// 重新编号为 [0, 不同 key 的个数)，访问模式与命中情况不变
+// 不同 key 的个数超过 INT_MAX 时抛出 std::length_error
+inline Trace DenseTrace(const Trace& trace) {
+  std::unordered_map<uint64_t, uint64_t> ids;
+  Trace dense;
+  dense.reserve(trace.size());
+  for (uint64_t key : trace) {
+    auto [it, inserted] = ids.try_emplace(key, ids.size());
+    if (inserted && it->second > static_cast<uint64_t>(INT_MAX)) {
+      throw std::length_error("too many distinct keys for int cache");
+    }
+    dense.push_back(it->second);
+  }
+  return dense;
+}
+
+// 把已由 DenseTrace 重新编号的 trace 回放到 LRUCache 或 LFUCache 上
+// key 均为非负数，直接用作值，不会与未命中时返回的 -1 混淆
+template <typename Cache>
+Result ReplayIntCache(const std::string& policy, size_t capacity,
+                      const Trace& dense) {
+  if (capacity > static_cast<size_t>(INT_MAX)) {
+    throw std::invalid_argument("capacity exceeds INT_MAX for int cache");
+  }
+  size_t heap = HeapBytes();
+  Cache cache(static_cast<int>(capacity));
+  // 这两个缓存没有 size()，按插入次数推算条目个数
+  struct Adapter {
+    Cache& cache;
+    size_t entries{0};
+    size_t size() const { return entries; }
+  } adapter{cache};
+  return Replay(policy, capacity, adapter, dense,
+                [capacity](Adapter& a, uint64_t key) {
+                  int k = static_cast<int>(key);
+                  if (a.cache.get(k) != -1) {
+                    return true;
+                  }
+                  a.cache.put(k, k);
+                  if (a.entries < capacity) {
+                    a.entries++;
+                  }
+                  return false;
+                },
+                heap);
+}
+
+// 以下函数各自新建一个容量为 capacity 的缓存并回放 trace
+// 值统一为 uint64_t，与 key 相同
+
+inline Result SimulateLRU(size_t capacity, const Trace& trace) {
+  return ReplayIntCache<LRUCache>("LRUCache", capacity, DenseTrace(trace));
+}
+
+inline Result SimulateLFU(size_t capacity, const Trace& trace) {
+  return ReplayIntCache<LFUCache>("LFUCache", capacity, DenseTrace(trace));
+}
+
+// 适用于 get 返回值指针的缓存：BasicLRUCache、BasicLFUCache、WTinyLFUCache
+template <typename Cache>
+Result SimulatePointerCache(const std::string& policy, size_t capacity,
+                            const Trace& trace) {
+  size_t heap = HeapBytes();
+  Cache cache(capacity);
+  return Replay(policy, capacity, cache, trace,
+                [](Cache& c, uint64_t key) {
+                  if (c.get(key) != nullptr) {
+                    return true;
+                  }
+                  c.put(key, key);
+                  return false;
+                },
+                heap);
+}
+
+inline Result SimulateClock(size_t capacity, const Trace& trace) {
+  using Cache = ClockCache<uint64_t, uint64_t, std::hash<uint64_t>>;
+  size_t heap = HeapBytes();
+  Cache cache(capacity);
+  return Replay("ClockCache", capacity, cache, trace,
+                [](Cache& c, uint64_t key) {
+                  uint64_t value;
+                  if (c.get(key, value)) {
+                    return true;
+                  }
+                  c.put(key, key);
+                  return false;
+                },
+                heap);
+}
+
+// 在每个容量下把 trace 回放到所有缓存策略上
+inline std::vector<Result> SimulateAll(const Trace& trace,
+                                       const std::vector<size_t>& capacities) {
+  using Hash = std::hash<uint64_t>;
+  // 重新编号只做一次，所有容量共用
+  Trace dense = DenseTrace(trace);
+  std::vector<Result> results;
+  for (size_t capacity : capacities) {
+    results.push_back(ReplayIntCache<LRUCache>("LRUCache", capacity, dense));
+    results.push_back(ReplayIntCache<LFUCache>("LFUCache", capacity, dense));
+    results.push_back(
+        SimulatePointerCache<BasicLRUCache<uint64_t, uint64_t, Hash>>(
+            "BasicLRUCache", capacity, trace));
+    results.push_back(
+        SimulatePointerCache<BasicLFUCache<uint64_t, uint64_t, Hash>>(
+            "BasicLFUCache", capacity, trace));
+    results.push_back(SimulateClock(capacity, trace));
+    results.push_back(
+        SimulatePointerCache<WTinyLFUCache<uint64_t, uint64_t, Hash>>(
+            "WTinyLFUCache", capacity, trace));
+  }
+  return results;
+}
+
+// 以表格形式输出结果
+inline void PrintResults(std::ostream& out, const std::vector<Result>& results) {
+  out << std::left << std::setw(16) << "policy" << std::right << std::setw(10)
+      << "capacity" << std::setw(12) << "hit ratio" << std::setw(14)
+      << "ops/sec" << std::setw(14) << "bytes/entry" << '\n';
+  for (const Result& r : results) {
+    out << std::left << std::setw(16) << r.policy << std::right
+        << std::setw(10) << r.capacity << std::setw(12) << std::fixed
+        << std::setprecision(4) << r.hit_ratio << std::setw(14)
+        << std::setprecision(0) << r.ops_per_sec << std::setw(14)
+        << std::setprecision(1) << r.bytes_per_entry << '\n';
+  }
+}
+
+}  // namespace cache_simulator
+
+}  // namespace xsf_data_structures
+
+#endif  // CACHE_SIMULATOR_H
@@ -0,0 +1,173 @@
+#ifndef CLOCK_CACHE_H
+#define CLOCK_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace xsf_data_structures {
+
+// CLOCK 缓存（二次机会算法），近似 LRU，线程安全
+// 所有条目存放在一个定长数组中，每个条目带一个访问位：
+// 1. 命中时只在读锁下把访问位置为 1（原子写），多个读线程之间互不阻塞，也不分配内存
+//    但命中并不是无锁的：获取、释放读锁都是对 shared_mutex 所在缓存行的原子读-改-写，
+//    读线程很多时这个缓存行会在核之间来回传递，命中的扩展性受它限制
+//    需要扩展到更多核时，可以像 ShardedLRUCache 一样按 key 分片，每个分片一个 ClockCache
+// 2. 需要逐出时，时钟指针沿数组循环扫描，访问位为 1 的条目清零后跳过（第二次机会），
+//    逐出第一个访问位为 0 的条目
+// 插入、删除在写锁下进行，条目的存储在构造时一次性分配，之后不再分配
+template <typename K, typename V, class Hash>
+class ClockCache {
+ public:
+  explicit ClockCache(size_t capacity)
+      : cap_(capacity), slots_(new Slot[capacity]) {
+    key2slot_.reserve(capacity);
+    free_.reserve(capacity);
+    for (size_t i = capacity; i > 0; i--) {
+      free_.push_back(i - 1);
+    }
+  }
+
+  ClockCache(const ClockCache&) = delete;
+  ClockCache& operator=(const ClockCache&) = delete;
+
+  // 找到 key 时把值复制到 value 中，并设置访问位
+  bool get(const K& key, V& value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = key2slot_.find(key);
+    if (it == key2slot_.end()) {
+      return false;
+    }
+    Slot& slot = slots_[it->second];
+    value = slot.val;
+    // 访问位已经为 1 时不再写入，避免热点条目的缓存行在多个核之间来回传递
+    if (!slot.referenced.load(std::memory_order_relaxed)) {
+      slot.referenced.store(true, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  bool contains(const K& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return key2slot_.find(key) != key2slot_.end();
+  }
+
+  void put(const K& key, const V& value) { putValue(key, value); }
+
+  void put(const K& key, V&& value) { putValue(key, std::move(value)); }
+
+  // key 不存在时返回 false
+  bool erase(const K& key) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = key2slot_.find(key);
+    if (it == key2slot_.end()) {
+      return false;
+    }
+    release(it->second);
+    key2slot_.erase(it);
+    return true;
+  }
+
+  void clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& [key, i] : key2slot_) {
+      release(i);
+    }
+    key2slot_.clear();
+  }
+
+  // 并发情况下只是一个瞬时值
+  size_t size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return key2slot_.size();
+  }
+
+  size_t capacity() const { return cap_; }
+
+ private:
+  struct Slot {
+    K key{};
+    V val{};
+    mutable std::atomic<bool> referenced{false};
+  };
+
+  template <typename Value>
+  void putValue(const K& key, Value&& value) {
+    if (cap_ == 0) {
+      return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = key2slot_.find(key);
+    if (it != key2slot_.end()) {
+      // 找到 key，更新
+      Slot& slot = slots_[it->second];
+      slot.val = std::forward<Value>(value);
+      slot.referenced.store(true, std::memory_order_relaxed);
+      return;
+    }
+    // 未找到 key，优先使用空闲条目，没有空闲条目时逐出一个
+    bool from_free = !free_.empty();
+    size_t i = from_free ? free_.back() : evict();
+    Slot& slot = slots_[i];
+    // 先填好条目再建立映射，复制 key、value 或插入映射抛出异常时，
+    // 条目留在（或归还到）空闲列表中，不会出现指向未填好的条目的映射
+    // free_ 在构造时已预留全部容量，push_back 不会抛出异常
+    try {
+      slot.key = key;
+      slot.val = std::forward<Value>(value);
+      key2slot_.emplace(key, i);
+    } catch (...) {
+      if (!from_free) {
+        free_.push_back(i);
+      }
+      throw;
+    }
+    if (from_free) {
+      free_.pop_back();
+    }
+    // 新条目的访问位为 0，若在指针转一圈之前都没有被访问，就会被逐出
+    slot.referenced.store(false, std::memory_order_relaxed);
+  }
+
+  // 移动时钟指针找到一个访问位为 0 的条目并逐出（删除它的映射），返回它的下标
+  // 最多扫描两圈：第一圈把所有访问位清零，第二圈必然找到
+  size_t evict() {
+    while (true) {
+      size_t i = hand_;
+      hand_ = hand_ + 1 == cap_ ? 0 : hand_ + 1;
+      Slot& slot = slots_[i];
+      if (slot.referenced.load(std::memory_order_relaxed)) {
+        // 第二次机会
+        slot.referenced.store(false, std::memory_order_relaxed);
+        continue;
+      }
+      key2slot_.erase(slot.key);
+      return i;
+    }
+  }
+
+  // 把条目 i 归还到空闲列表中，并释放值占用的资源
+  void release(size_t i) {
+    Slot& slot = slots_[i];
+    slot.key = K{};
+    slot.val = V{};
+    slot.referenced.store(false, std::memory_order_relaxed);
+    free_.push_back(i);
+  }
+
+  size_t cap_;
+  std::unique_ptr<Slot[]> slots_;
+  std::unordered_map<K, size_t, Hash> key2slot_;
+  std::vector<size_t> free_;  // 空闲条目的下标
+  size_t hand_{0};            // 时钟指针，仅在写锁下移动
+  mutable std::shared_mutex mutex_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // CLOCK_CACHE_H
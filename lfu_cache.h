@@ -1,8 +1,15 @@
 #ifndef LFU_CACHE_H
 #define LFU_CACHE_H
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <list>
 #include <unordered_map>
+#include <utility>
+
+#include "timing_wheel.h"
 
 namespace xsf_data_structures {
 
@@ -97,6 +104,453 @@ class LFUCache {
   std::unordered_map<int, std::list<Node>::iterator> key2node_;
 };
 
+// 泛型 LFU 缓存，非线程安全，get、put 都是 O(1)
+// 与 LFUCache 相比只用一个哈希表，频率节点按频率从小到大组成链表：
+// 1. 每个频率节点保存该频率下的所有条目，按访问时间从旧到新排列
+// 2. 每个条目记录它所在的频率节点，访问时把条目 splice 到下一个频率节点，不分配也不释放内存
+//    只有下一个频率节点不存在时才新建，原频率节点变空时删除
+// 3. 逐出时取第一个频率节点中最旧的条目
+// 可选的衰减（老化）：每 decay_interval 次访问把所有频率减半，让过去的热点逐渐被逐出
+template <typename K, typename V, class Hash>
+class BasicLFUCache {
+ public:
+  // decay_interval 为 0 时不自动衰减
+  explicit BasicLFUCache(size_t capacity, size_t decay_interval = 0)
+      : cap_(capacity), decay_interval_(decay_interval) {}
+
+  // 找到 key 时增加它的频率，返回值的指针，否则返回 null
+  // 指针在下一次修改缓存之前有效
+  V* get(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return nullptr;
+    }
+    auto node = it->second;
+    increaseFreq(node);
+    tick();
+    return &node->val;
+  }
+
+  void put(const K& key, const V& value) { putValue(key, value); }
+
+  void put(const K& key, V&& value) { putValue(key, std::move(value)); }
+
+  // key 不存在时返回 false
+  bool erase(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return false;
+    }
+    auto bucket = it->second->bucket;
+    bucket->nodes.erase(it->second);
+    if (bucket->nodes.empty()) {
+      buckets_.erase(bucket);
+    }
+    key2node_.erase(it);
+    return true;
+  }
+
+  void clear() {
+    buckets_.clear();
+    key2node_.clear();
+    accesses_ = 0;
+  }
+
+  // 把所有频率减半（至少为 1），相邻的频率节点减半后相同时合并
+  // 合并时原频率较低的条目排在前面，先被逐出
+  void decay() {
+    auto bucket = buckets_.begin();
+    while (bucket != buckets_.end()) {
+      bucket->freq = bucket->freq / 2 > 0 ? bucket->freq / 2 : 1;
+      if (bucket != buckets_.begin()) {
+        auto prev = std::prev(bucket);
+        if (prev->freq == bucket->freq) {
+          for (Node& node : bucket->nodes) {
+            node.bucket = prev;
+          }
+          prev->nodes.splice(prev->nodes.end(), bucket->nodes);
+          bucket = buckets_.erase(bucket);
+          continue;
+        }
+      }
+      ++bucket;
+    }
+  }
+
+  // 返回 key 当前的频率，key 不存在时返回 0
+  size_t frequency(const K& key) const {
+    auto it = key2node_.find(key);
+    return it == key2node_.end() ? 0 : it->second->bucket->freq;
+  }
+
+  size_t size() const { return key2node_.size(); }
+
+  size_t capacity() const { return cap_; }
+
+ private:
+  struct Bucket;
+
+  struct Node {
+    K key;
+    V val;
+    typename std::list<Bucket>::iterator bucket;  // 所在的频率节点
+  };
+
+  struct Bucket {
+    size_t freq;
+    std::list<Node> nodes;
+  };
+
+  using NodeIter = typename std::list<Node>::iterator;
+
+  template <typename Value>
+  void putValue(const K& key, Value&& value) {
+    if (cap_ == 0) {
+      return;
+    }
+    auto it = key2node_.find(key);
+    if (it != key2node_.end()) {
+      // key 已存在，更新
+      it->second->val = std::forward<Value>(value);
+      increaseFreq(it->second);
+      tick();
+      return;
+    }
+    // key 不存在，加入
+    if (key2node_.size() + 1 > cap_) {
+      // 加入后超出容量，需逐出
+      removeMinFreqKey();
+    }
+    // 新加入，频率为 1，放在第一个频率节点中
+    if (buckets_.empty() || buckets_.front().freq != 1) {
+      buckets_.push_front(Bucket{1, {}});
+    }
+    auto bucket = buckets_.begin();
+    // 复制或移动 key、value 以及插入映射都可能抛出异常，此时撤销已做的修改，
+    // 新建的频率节点为空时删除，保持 buckets_ 不含空节点
+    bool pushed = false;
+    try {
+      bucket->nodes.push_back(Node{key, std::forward<Value>(value), bucket});
+      pushed = true;
+      key2node_.emplace(key, std::prev(bucket->nodes.end()));
+    } catch (...) {
+      if (pushed) {
+        bucket->nodes.pop_back();
+      }
+      if (bucket->nodes.empty()) {
+        buckets_.erase(bucket);
+      }
+      throw;
+    }
+    tick();
+  }
+
+  void increaseFreq(NodeIter node) {
+    auto bucket = node->bucket;
+    auto next = std::next(bucket);
+    if (next == buckets_.end() || next->freq != bucket->freq + 1) {
+      // 下一个频率节点不存在，新建
+      next = buckets_.insert(next, Bucket{bucket->freq + 1, {}});
+    }
+    // 移到新频率节点的末尾，迭代器保持有效
+    next->nodes.splice(next->nodes.end(), bucket->nodes, node);
+    node->bucket = next;
+    if (bucket->nodes.empty()) {
+      buckets_.erase(bucket);
+    }
+  }
+
+  void removeMinFreqKey() {
+    // 第一个频率节点中最旧的条目
+    auto bucket = buckets_.begin();
+    key2node_.erase(bucket->nodes.front().key);
+    bucket->nodes.pop_front();
+    if (bucket->nodes.empty()) {
+      buckets_.erase(bucket);
+    }
+  }
+
+  // 记录一次访问，达到衰减周期时衰减
+  void tick() {
+    if (decay_interval_ != 0 && ++accesses_ >= decay_interval_) {
+      accesses_ = 0;
+      decay();
+    }
+  }
+
+  size_t cap_;
+  size_t decay_interval_;
+  size_t accesses_{0};
+  std::list<Bucket> buckets_;  // 按频率从小到大排列，不含空节点
+  std::unordered_map<K, NodeIter, Hash> key2node_;
+};
+
+// 按权重（如字节数）限制容量、支持过期时间（TTL）的 LFU 缓存，非线程安全
+// 频率的组织方式与 BasicLFUCache 相同，权重和过期的规则与 WeightedLRUCache 相同：
+// 1. 权重由 weigher(key, value) 计算，未提供 weigher 时每个条目的权重为 1
+//    插入后总权重超出 max_weight 时，从频率最低（同频率中最旧）的条目开始逐出，
+//    刚插入或更新的条目不会被逐出，权重本身就超过 max_weight 的条目不会被插入
+// 2. put 时可以指定 ttl，get 时发现条目已过期则删除并视为未命中（惰性过期），
+//    不再被访问的过期条目由时间轮（TimingWheel）定期清理
+// decay_interval 不为 0 时，每 decay_interval 次访问把所有频率减半
+// Clock 为时钟类型，需提供 now() 和 duration、time_point，默认为 steady_clock
+template <typename K, typename V, class Hash,
+          class Clock = std::chrono::steady_clock>
+class WeightedLFUCache {
+ private:
+  struct Bucket;
+  struct Node;
+  using NodeIter = typename std::list<Node>::iterator;
+  using Wheel = TimingWheel<NodeIter, Clock>;
+
+ public:
+  using Weigher = std::function<size_t(const K&, const V&)>;
+  using Duration = typename Clock::duration;
+  using TimePoint = typename Clock::time_point;
+
+  explicit WeightedLFUCache(size_t max_weight, Weigher weigher = nullptr,
+                            Duration tick = std::chrono::seconds(1),
+                            size_t decay_interval = 0)
+      : max_weight_(max_weight),
+        weigher_(std::move(weigher)),
+        decay_interval_(decay_interval),
+        wheel_(tick, Clock::now()) {}
+
+  // 找到未过期的 key 时增加它的频率，返回值的指针，否则返回 null
+  // 指针在下一次修改缓存之前有效
+  V* get(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return nullptr;
+    }
+    NodeIter node = it->second;
+    if (node->expires && node->expiry <= Clock::now()) {
+      // 惰性过期
+      removeNode(node);
+      return nullptr;
+    }
+    increaseFreq(node);
+    tick();
+    return &node->val;
+  }
+
+  // ttl 为 0 时永不过期，条目的权重超过 max_weight 时不插入并返回 false
+  // key 已存在时同时替换值和过期时间，并增加它的频率
+  bool put(const K& key, const V& value, Duration ttl = Duration::zero()) {
+    return putValue(key, value, ttl);
+  }
+
+  bool put(const K& key, V&& value, Duration ttl = Duration::zero()) {
+    return putValue(key, std::move(value), ttl);
+  }
+
+  // key 不存在时返回 false
+  bool erase(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return false;
+    }
+    removeNode(it->second);
+    return true;
+  }
+
+  void clear() {
+    wheel_.clear();
+    buckets_.clear();
+    key2node_.clear();
+    weight_ = 0;
+    accesses_ = 0;
+  }
+
+  // 清理时间轮中到期的槽，可以由后台定期调用，put 时也会自动调用
+  void expire() {
+    wheel_.advance(Clock::now(), [this](NodeIter node) { removeNode(node); });
+  }
+
+  // 把所有频率减半（至少为 1），相邻的频率节点减半后相同时合并
+  // 合并时原频率较低的条目排在前面，先被逐出
+  void decay() {
+    auto bucket = buckets_.begin();
+    while (bucket != buckets_.end()) {
+      bucket->freq = bucket->freq / 2 > 0 ? bucket->freq / 2 : 1;
+      if (bucket != buckets_.begin()) {
+        auto prev = std::prev(bucket);
+        if (prev->freq == bucket->freq) {
+          for (Node& node : bucket->nodes) {
+            node.bucket = prev;
+          }
+          prev->nodes.splice(prev->nodes.end(), bucket->nodes);
+          bucket = buckets_.erase(bucket);
+          continue;
+        }
+      }
+      ++bucket;
+    }
+  }
+
+  // 返回 key 当前的频率，key 不存在时返回 0
+  size_t frequency(const K& key) const {
+    auto it = key2node_.find(key);
+    return it == key2node_.end() ? 0 : it->second->bucket->freq;
+  }
+
+  size_t size() const { return key2node_.size(); }
+
+  // 当前的总权重
+  size_t weight() const { return weight_; }
+
+  size_t maxWeight() const { return max_weight_; }
+
+ private:
+  struct Node {
+    K key;
+    V val;
+    typename std::list<Bucket>::iterator bucket;  // 所在的频率节点
+    size_t weight;
+    bool expires;                 // 是否设置了过期时间
+    TimePoint expiry;             // 过期时刻
+    typename Wheel::Timer timer;  // expires 为 true 时，在时间轮中的位置
+  };
+
+  struct Bucket {
+    size_t freq;
+    std::list<Node> nodes;
+  };
+
+  template <typename Value>
+  bool putValue(const K& key, Value&& value, Duration ttl) {
+    TimePoint now = Clock::now();
+    wheel_.advance(now, [this](NodeIter node) { removeNode(node); });
+    size_t w = weigher_ ? weigher_(key, value) : 1;
+    auto it = key2node_.find(key);
+    if (w > max_weight_) {
+      // 放不下，旧值也一并删除，避免之后读到过时的值
+      if (it != key2node_.end()) {
+        removeNode(it->second);
+      }
+      return false;
+    }
+    NodeIter node;
+    if (it != key2node_.end()) {
+      // 找到 key，更新，先赋值，赋值抛出异常时权重和过期时间保持不变
+      node = it->second;
+      node->val = std::forward<Value>(value);
+      increaseFreq(node);
+      unschedule(node);
+      weight_ -= node->weight;
+    } else {
+      node = insertNode(key, std::forward<Value>(value));
+    }
+    node->weight = w;
+    weight_ += w;
+    if (ttl > Duration::zero()) {
+      schedule(node, now + ttl);
+    }
+    evictExcept(node);
+    tick();
+    return true;
+  }
+
+  // 新加入的条目频率为 1，放在第一个频率节点的末尾
+  // 复制或移动 key、value 以及插入映射抛出异常时撤销已做的修改，保持 buckets_ 不含空节点
+  template <typename Value>
+  NodeIter insertNode(const K& key, Value&& value) {
+    if (buckets_.empty() || buckets_.front().freq != 1) {
+      buckets_.push_front(Bucket{1, {}});
+    }
+    auto bucket = buckets_.begin();
+    bool pushed = false;
+    try {
+      bucket->nodes.push_back(
+          Node{key, std::forward<Value>(value), bucket, 0, false, {}, {}});
+      pushed = true;
+      key2node_.emplace(key, std::prev(bucket->nodes.end()));
+    } catch (...) {
+      if (pushed) {
+        bucket->nodes.pop_back();
+      }
+      if (bucket->nodes.empty()) {
+        buckets_.erase(bucket);
+      }
+      throw;
+    }
+    return std::prev(bucket->nodes.end());
+  }
+
+  // 总权重超出 max_weight 时，逐出频率最低（同频率中最旧）的条目，跳过 keep
+  // keep 的权重不超过 max_weight，逐出其他所有条目后一定能放下
+  void evictExcept(NodeIter keep) {
+    while (weight_ > max_weight_) {
+      auto bucket = buckets_.begin();
+      NodeIter victim = bucket->nodes.begin();
+      if (victim == keep) {
+        victim = std::next(victim) != bucket->nodes.end()
+                     ? std::next(victim)
+                     : std::next(bucket)->nodes.begin();
+      }
+      removeNode(victim);
+    }
+  }
+
+  void increaseFreq(NodeIter node) {
+    auto bucket = node->bucket;
+    auto next = std::next(bucket);
+    if (next == buckets_.end() || next->freq != bucket->freq + 1) {
+      // 下一个频率节点不存在，新建
+      next = buckets_.insert(next, Bucket{bucket->freq + 1, {}});
+    }
+    // 移到新频率节点的末尾，迭代器保持有效
+    next->nodes.splice(next->nodes.end(), bucket->nodes, node);
+    node->bucket = next;
+    if (bucket->nodes.empty()) {
+      buckets_.erase(bucket);
+    }
+  }
+
+  // 把 node 放入时间轮
+  void schedule(NodeIter node, TimePoint expiry) {
+    node->timer = wheel_.schedule(node, expiry);
+    node->expires = true;
+    node->expiry = expiry;
+  }
+
+  // 把 node 从时间轮中移除
+  void unschedule(NodeIter node) {
+    if (node->expires) {
+      wheel_.unschedule(node->timer);
+      node->expires = false;
+    }
+  }
+
+  void removeNode(NodeIter node) {
+    unschedule(node);
+    weight_ -= node->weight;
+    key2node_.erase(node->key);
+    auto bucket = node->bucket;
+    bucket->nodes.erase(node);
+    if (bucket->nodes.empty()) {
+      buckets_.erase(bucket);
+    }
+  }
+
+  // 记录一次访问，达到衰减周期时衰减
+  void tick() {
+    if (decay_interval_ != 0 && ++accesses_ >= decay_interval_) {
+      accesses_ = 0;
+      decay();
+    }
+  }
+
+  size_t max_weight_;
+  Weigher weigher_;
+  size_t decay_interval_;
+  size_t accesses_{0};
+  size_t weight_{0};
+  std::list<Bucket> buckets_;  // 按频率从小到大排列，不含空节点
+  std::unordered_map<K, NodeIter, Hash> key2node_;
+  Wheel wheel_;
+};
+
 }  // namespace xsf_data_structures
 
 #endif  // LFU_CACHE_H
\ No newline at end of file
@@ -1,8 +1,18 @@
 #ifndef LRU_CACHE_H
 #define LRU_CACHE_H
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "timing_wheel.h"
 
 namespace xsf_data_structures {
 
@@ -63,6 +73,377 @@ class LRUCache {
   std::unordered_map<int, std::list<Node>::iterator> key2node_;
 };
 
+// 泛型 LRU 缓存，非线程安全
+// 与 LRUCache 相比，每次 get、put 只查找一次哈希表：
+// 哈希表直接保存链表迭代器，命中时用 splice 把节点移到链表尾部，不分配也不释放内存
+template <typename K, typename V, class Hash>
+class BasicLRUCache {
+ public:
+  explicit BasicLRUCache(size_t capacity) : cap_(capacity) {}
+
+  // 找到 key 时将其标记为最近使用，返回值的指针，否则返回 null
+  // 指针在下一次修改缓存之前有效
+  V* get(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return nullptr;
+    }
+    makeRecently(it->second);
+    return &it->second->val;
+  }
+
+  // 同 get，但不改变使用顺序
+  V* peek(const K& key) {
+    auto it = key2node_.find(key);
+    return it == key2node_.end() ? nullptr : &it->second->val;
+  }
+
+  void put(const K& key, const V& value) { putValue(key, value); }
+
+  void put(const K& key, V&& value) { putValue(key, std::move(value)); }
+
+  // key 不存在时返回 false
+  bool erase(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return false;
+    }
+    list_.erase(it->second);
+    key2node_.erase(it);
+    return true;
+  }
+
+  void clear() {
+    list_.clear();
+    key2node_.clear();
+  }
+
+  // 返回最久未使用的 key，不改变使用顺序，缓存为空时返回 null
+  const K* victim() const {
+    return list_.empty() ? nullptr : &list_.front().key;
+  }
+
+  // 取出最久未使用的条目，缓存为空时返回 false
+  bool pop(K& key, V& value) {
+    if (list_.empty()) {
+      return false;
+    }
+    key = std::move(list_.front().key);
+    value = std::move(list_.front().val);
+    key2node_.erase(key);
+    list_.pop_front();
+    return true;
+  }
+
+  size_t size() const { return key2node_.size(); }
+
+  size_t capacity() const { return cap_; }
+
+ private:
+  struct Node {
+    K key;
+    V val;
+  };
+
+  template <typename Value>
+  void putValue(const K& key, Value&& value) {
+    if (cap_ == 0) {
+      return;
+    }
+    // 一次查找同时完成“是否存在”的判断和新 key 的插入
+    auto [it, inserted] = key2node_.try_emplace(key, list_.end());
+    if (!inserted) {
+      // 找到 key，更新
+      it->second->val = std::forward<Value>(value);
+      makeRecently(it->second);
+      return;
+    }
+    // 未找到 key，加入，复制或移动 key、value 抛出异常时撤销刚插入的映射
+    try {
+      list_.push_back(Node{key, std::forward<Value>(value)});
+    } catch (...) {
+      key2node_.erase(it);
+      throw;
+    }
+    it->second = std::prev(list_.end());
+    if (list_.size() > cap_) {
+      // 加入后超出容量，需逐出
+      popLeastRecently();
+    }
+  }
+
+  void makeRecently(typename std::list<Node>::iterator node) {
+    // 移至链表后端，只调整指针
+    list_.splice(list_.end(), list_, node);
+  }
+
+  void popLeastRecently() {
+    key2node_.erase(list_.front().key);
+    list_.pop_front();
+  }
+
+  size_t cap_;
+  std::list<Node> list_;
+  std::unordered_map<K, typename std::list<Node>::iterator, Hash> key2node_;
+};
+
+// 分片的线程安全 LRU 缓存
+// 按 key 的哈希值把 key 分配到多个分片，每个分片是一个独立加锁的 BasicLRUCache
+// 不同分片上的操作互不阻塞，分片越多锁竞争越少，但 LRU 顺序只在分片内部成立
+// 总容量平均分配给各个分片，余数分给前几个分片，各分片容量之和恰好等于总容量
+// 分片数不超过总容量，避免出现容量为 0、永远无法缓存的分片
+template <typename K, typename V, class Hash>
+class ShardedLRUCache {
+ public:
+  explicit ShardedLRUCache(size_t capacity, size_t shard_count = 16) {
+    if (shard_count > capacity) {
+      shard_count = capacity;
+    }
+    if (shard_count == 0) {
+      shard_count = 1;
+    }
+    for (size_t i = 0; i < shard_count; i++) {
+      size_t shard_capacity =
+          capacity / shard_count + (i < capacity % shard_count ? 1 : 0);
+      shards_.push_back(std::make_unique<Shard>(shard_capacity));
+    }
+  }
+
+  // 找到 key 时把值复制到 value 中
+  bool get(const K& key, V& value) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    V* found = shard.cache.get(key);
+    if (found == nullptr) {
+      return false;
+    }
+    value = *found;
+    return true;
+  }
+
+  void put(const K& key, const V& value) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache.put(key, value);
+  }
+
+  void put(const K& key, V&& value) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache.put(key, std::move(value));
+  }
+
+  bool erase(const K& key) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.erase(key);
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->cache.clear();
+    }
+  }
+
+  // 并发情况下只是一个瞬时值
+  size_t size() const {
+    size_t total = 0;
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total += shard->cache.size();
+    }
+    return total;
+  }
+
+  size_t shardCount() const { return shards_.size(); }
+
+ private:
+  // 每个分片独占缓存行，避免相邻分片的锁之间伪共享
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    BasicLRUCache<K, V, Hash> cache;
+
+    explicit Shard(size_t capacity) : cache(capacity) {}
+  };
+
+  Shard& shardOf(const K& key) {
+    // 分片内部的哈希表使用哈希值的低位，这里乘以黄金分割数后取高位，使两者相互独立
+    uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return *shards_[(h >> 32) % shards_.size()];
+  }
+
+  Hash hash_{};
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+// 按权重（如字节数）限制容量、支持过期时间（TTL）的 LRU 缓存，非线程安全
+// 1. 权重：每个条目的权重由 weigher(key, value) 计算，未提供 weigher 时每个条目的权重为 1
+//    插入后总权重超出 max_weight 时，从最久未使用的条目开始逐出，直到总权重不超过 max_weight
+//    权重本身就超过 max_weight 的条目不会被插入
+// 2. 过期：put 时可以指定 ttl，get 时发现条目已过期则删除并视为未命中（惰性过期）
+//    不再被访问的过期条目由时间轮（TimingWheel）定期清理，不必等到它们移动到 LRU 链表头部才被逐出
+//    时间轮的每个槽对应 tick 长的时间，每次 put 或调用 expire 时清理从上次清理到现在经过的槽
+// Clock 为时钟类型，需提供 now() 和 duration、time_point，默认为 steady_clock
+template <typename K, typename V, class Hash,
+          class Clock = std::chrono::steady_clock>
+class WeightedLRUCache {
+ private:
+  struct Node;
+  using NodeIter = typename std::list<Node>::iterator;
+  using Wheel = TimingWheel<NodeIter, Clock>;
+
+ public:
+  using Weigher = std::function<size_t(const K&, const V&)>;
+  using Duration = typename Clock::duration;
+  using TimePoint = typename Clock::time_point;
+
+  explicit WeightedLRUCache(size_t max_weight, Weigher weigher = nullptr,
+                            Duration tick = std::chrono::seconds(1))
+      : max_weight_(max_weight),
+        weigher_(std::move(weigher)),
+        wheel_(tick, Clock::now()) {}
+
+  // 找到未过期的 key 时将其标记为最近使用，返回值的指针，否则返回 null
+  // 指针在下一次修改缓存之前有效
+  V* get(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return nullptr;
+    }
+    NodeIter node = it->second;
+    if (node->expires && node->expiry <= Clock::now()) {
+      // 惰性过期
+      removeNode(node);
+      return nullptr;
+    }
+    list_.splice(list_.end(), list_, node);
+    return &node->val;
+  }
+
+  // ttl 为 0 时永不过期，条目的权重超过 max_weight 时不插入并返回 false
+  // key 已存在时同时替换值和过期时间
+  bool put(const K& key, const V& value, Duration ttl = Duration::zero()) {
+    return putValue(key, value, ttl);
+  }
+
+  bool put(const K& key, V&& value, Duration ttl = Duration::zero()) {
+    return putValue(key, std::move(value), ttl);
+  }
+
+  // key 不存在时返回 false
+  bool erase(const K& key) {
+    auto it = key2node_.find(key);
+    if (it == key2node_.end()) {
+      return false;
+    }
+    removeNode(it->second);
+    return true;
+  }
+
+  void clear() {
+    wheel_.clear();
+    list_.clear();
+    key2node_.clear();
+    weight_ = 0;
+  }
+
+  // 清理时间轮中到期的槽，可以由后台定期调用，put 时也会自动调用
+  void expire() {
+    wheel_.advance(Clock::now(), [this](NodeIter node) { removeNode(node); });
+  }
+
+  size_t size() const { return key2node_.size(); }
+
+  // 当前的总权重
+  size_t weight() const { return weight_; }
+
+  size_t maxWeight() const { return max_weight_; }
+
+ private:
+  struct Node {
+    K key;
+    V val;
+    size_t weight;
+    bool expires;                 // 是否设置了过期时间
+    TimePoint expiry;             // 过期时刻
+    typename Wheel::Timer timer;  // expires 为 true 时，在时间轮中的位置
+  };
+
+  template <typename Value>
+  bool putValue(const K& key, Value&& value, Duration ttl) {
+    TimePoint now = Clock::now();
+    wheel_.advance(now, [this](NodeIter node) { removeNode(node); });
+    size_t w = weigher_ ? weigher_(key, value) : 1;
+    auto it = key2node_.find(key);
+    if (w > max_weight_) {
+      // 放不下，旧值也一并删除，避免之后读到过时的值
+      if (it != key2node_.end()) {
+        removeNode(it->second);
+      }
+      return false;
+    }
+    NodeIter node;
+    if (it != key2node_.end()) {
+      // 找到 key，更新，先赋值，赋值抛出异常时权重和过期时间保持不变
+      node = it->second;
+      node->val = std::forward<Value>(value);
+      unschedule(node);
+      weight_ -= node->weight;
+      list_.splice(list_.end(), list_, node);
+    } else {
+      // 未找到 key，加入，插入映射抛出异常时撤销刚加入的节点
+      list_.push_back(Node{key, std::forward<Value>(value), 0, false, {}, {}});
+      node = std::prev(list_.end());
+      try {
+        key2node_.emplace(key, node);
+      } catch (...) {
+        list_.pop_back();
+        throw;
+      }
+    }
+    node->weight = w;
+    weight_ += w;
+    if (ttl > Duration::zero()) {
+      schedule(node, now + ttl);
+    }
+    // 超出总权重，从最久未使用的条目开始逐出，node 在链表尾部，最后才会被考虑
+    while (weight_ > max_weight_) {
+      removeNode(list_.begin());
+    }
+    return true;
+  }
+
+  // 把 node 放入时间轮
+  void schedule(NodeIter node, TimePoint expiry) {
+    node->timer = wheel_.schedule(node, expiry);
+    node->expires = true;
+    node->expiry = expiry;
+  }
+
+  // 把 node 从时间轮中移除
+  void unschedule(NodeIter node) {
+    if (node->expires) {
+      wheel_.unschedule(node->timer);
+      node->expires = false;
+    }
+  }
+
+  void removeNode(NodeIter node) {
+    unschedule(node);
+    weight_ -= node->weight;
+    key2node_.erase(node->key);
+    list_.erase(node);
+  }
+
+  size_t max_weight_;
+  Weigher weigher_;
+  size_t weight_{0};
+  std::list<Node> list_;
+  std::unordered_map<K, NodeIter, Hash> key2node_;
+  Wheel wheel_;
+};
+
 }  // namespace xsf_data_structures
 
 #endif  // LRU_CACHE_H
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <utility>
+
+namespace xsf_data_structures {
+
+// 单层时间轮，供带过期时间（TTL）的缓存定期清理过期条目，非线程安全
+// 有 kSlots_ 个槽，每个槽对应 tick 长的时间，保存将在该 tick 过期的条目的句柄 Handle
+// advance(now) 清理从上次清理到 now 经过的槽，对其中已经过期的条目调用回调
+// 过期时间超过时间轮一圈的条目在中途被扫到时保留，等下一圈再处理
+// Clock 为时钟类型，需提供 duration、time_point
+template <typename Handle, class Clock>
+class TimingWheel {
+ private:
+  using Entry = std::pair<Handle, typename Clock::time_point>;
+
+ public:
+  using Duration = typename Clock::duration;
+  using TimePoint = typename Clock::time_point;
+
+  // 条目在时间轮中的位置，由 schedule 返回，unschedule 时使用
+  struct Timer {
+    size_t slot{0};
+    typename std::list<Entry>::iterator pos{};
+  };
+
+  // tick 不大于 0 时取最小的时间单位
+  TimingWheel(Duration tick, TimePoint now)
+      : tick_(tick > Duration::zero() ? tick : Duration(1)),
+        last_tick_(ticks(now)) {}
+
+  // 在过期时刻 expiry 所在 tick 的下一个 tick 对应的槽中登记 handle，
+  // 保证清理到该槽时条目已经过期
+  Timer schedule(const Handle& handle, TimePoint expiry) {
+    uint64_t t = ticks(expiry) + 1;
+    if (t <= last_tick_) {
+      t = last_tick_ + 1;
+    }
+    Timer timer;
+    timer.slot = t % kSlots_;
+    slots_[timer.slot].emplace_back(handle, expiry);
+    timer.pos = std::prev(slots_[timer.slot].end());
+    return timer;
+  }
+
+  void unschedule(const Timer& timer) { slots_[timer.slot].erase(timer.pos); }
+
+  // 清理从上次清理之后到 now 所在 tick 之间的槽，对其中过期时刻不晚于 now 的条目
+  // 调用 on_expired(handle)，回调中可以 unschedule 该条目，但不能 unschedule 其他条目
+  template <typename F>
+  void advance(TimePoint now, F&& on_expired) {
+    uint64_t now_tick = ticks(now);
+    if (now_tick <= last_tick_) {
+      return;
+    }
+    uint64_t count = now_tick - last_tick_;
+    if (count > kSlots_) {
+      count = kSlots_;
+    }
+    for (uint64_t t = now_tick - count + 1; t <= now_tick; t++) {
+      auto& slot = slots_[t % kSlots_];
+      for (auto it = slot.begin(); it != slot.end();) {
+        auto [handle, expiry] = *it;
+        ++it;
+        if (expiry <= now) {
+          on_expired(handle);
+        }
+      }
+    }
+    last_tick_ = now_tick;
+  }
+
+  void clear() {
+    for (auto& slot : slots_) {
+      slot.clear();
+    }
+  }
+
+ private:
+  static const size_t kSlots_{256};
+
+  uint64_t ticks(TimePoint t) const {
+    return static_cast<uint64_t>(t.time_since_epoch() / tick_);
+  }
+
+  Duration tick_;
+  uint64_t last_tick_;  // 上次清理到的 tick
+  std::list<Entry> slots_[kSlots_];
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // TIMING_WHEEL_H
@@ -0,0 +1,236 @@
+#ifndef TINY_LFU_CACHE_H
+#define TINY_LFU_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "lru_cache.h"
+
+namespace xsf_data_structures {
+
+// Count-Min Sketch 频率估计器，每个计数器 4 位（最大 15），用于 W-TinyLFU 的准入判断
+// 4 行计数器，每行用不同的哈希函数，估计值取 4 行中的最小值，只会高估不会低估
+// 累计增加 sample_size 次后把所有计数器减半，使频率随时间衰减，过去的热点逐渐失效
+template <typename K, class Hash>
+class FrequencySketch {
+ public:
+  // 宽度取不小于 width 的 2 的指数，每个字节存放两个计数器
+  FrequencySketch(size_t width, size_t sample_size) : sample_size_(sample_size) {
+    width_ = 16;
+    while (width_ < width) {
+      width_ *= 2;
+    }
+    table_.assign(kDepth_ * width_ / 2, 0);
+  }
+
+  void increment(const K& key) {
+    uint64_t h = hash_(key);
+    bool added = false;
+    for (size_t i = 0; i < kDepth_; i++) {
+      size_t j = index(h, i);
+      uint8_t count = counter(j);
+      if (count < kMaxCount_) {
+        setCounter(j, count + 1);
+        added = true;
+      }
+    }
+    if (added && ++additions_ >= sample_size_) {
+      halve();
+    }
+  }
+
+  // 返回 key 的估计频率
+  uint8_t estimate(const K& key) const {
+    uint64_t h = hash_(key);
+    uint8_t result = kMaxCount_;
+    for (size_t i = 0; i < kDepth_; i++) {
+      uint8_t count = counter(index(h, i));
+      if (count < result) {
+        result = count;
+      }
+    }
+    return result;
+  }
+
+  // 所有计数器减半
+  void halve() {
+    for (uint8_t& byte : table_) {
+      // 同时处理一个字节中的两个计数器
+      byte = (byte >> 1) & 0x77;
+    }
+    additions_ /= 2;
+  }
+
+  void clear() {
+    table_.assign(table_.size(), 0);
+    additions_ = 0;
+  }
+
+ private:
+  static const size_t kDepth_{4};
+  static const uint8_t kMaxCount_{15};
+
+  // 第 row 行中 key 对应的计数器的全局下标
+  size_t index(uint64_t h, size_t row) const {
+    static constexpr uint64_t kSeeds[kDepth_]{
+        0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+        0xD6E8FEB86659FD93ull};
+    uint64_t x = (h + row) * kSeeds[row];
+    x ^= x >> 32;
+    return row * width_ + (x & (width_ - 1));
+  }
+
+  uint8_t counter(size_t j) const {
+    return (table_[j / 2] >> ((j % 2) * 4)) & 0x0F;
+  }
+
+  void setCounter(size_t j, uint8_t count) {
+    size_t shift = (j % 2) * 4;
+    table_[j / 2] = (table_[j / 2] & ~(0x0F << shift)) | (count << shift);
+  }
+
+  Hash hash_{};
+  size_t width_;
+  size_t sample_size_;
+  size_t additions_{0};
+  std::vector<uint8_t> table_;
+};
+
+// W-TinyLFU 缓存，非线程安全
+// 由三个 BasicLRUCache 和一个 FrequencySketch 组成：
+// 1. 窗口 LRU（约 1% 容量）：新 key 总是先进入窗口，吸收突发的新访问
+// 2. 主区域为分段 LRU（SLRU）：试用段 probation 和保护段 protected（约占主区域的 80%）
+//    试用段中的条目再次被访问时晋升到保护段，保护段满时最旧的条目降级回试用段
+// 3. 准入过滤：窗口逐出的候选条目只有在估计频率高于试用段的逐出条目时才能进入主区域，
+//    否则直接丢弃，因此一次性扫描的大量冷数据无法冲掉主区域中的热点
+// 所有访问（包括未命中）都计入频率估计
+template <typename K, typename V, class Hash>
+class WTinyLFUCache {
+ public:
+  explicit WTinyLFUCache(size_t capacity)
+      : cap_(capacity),
+        window_(windowCapacity(capacity)),
+        probation_(capacity - windowCapacity(capacity)),
+        protected_((capacity - windowCapacity(capacity)) * 4 / 5),
+        sketch_(capacity, 10 * (capacity > 16 ? capacity : 16)) {}
+
+  // 找到 key 时返回值的指针，否则返回 null，指针在下一次修改缓存之前有效
+  V* get(const K& key) {
+    sketch_.increment(key);
+    return find(key);
+  }
+
+  void put(const K& key, const V& value) { putValue(key, value); }
+
+  void put(const K& key, V&& value) { putValue(key, std::move(value)); }
+
+  // key 不存在时返回 false
+  bool erase(const K& key) {
+    return window_.erase(key) || probation_.erase(key) ||
+           protected_.erase(key);
+  }
+
+  // 清空所有条目和频率估计
+  void clear() {
+    window_.clear();
+    probation_.clear();
+    protected_.clear();
+    sketch_.clear();
+  }
+
+  size_t size() const {
+    return window_.size() + probation_.size() + protected_.size();
+  }
+
+  size_t capacity() const { return cap_; }
+
+ private:
+  // 窗口占总容量的 1%，至少为 1
+  static size_t windowCapacity(size_t capacity) {
+    if (capacity == 0) {
+      return 0;
+    }
+    return capacity / 100 > 0 ? capacity / 100 : 1;
+  }
+
+  // 在三个区域中查找 key，命中试用段时晋升到保护段
+  V* find(const K& key) {
+    if (V* value = window_.get(key)) {
+      return value;
+    }
+    if (V* value = protected_.get(key)) {
+      return value;
+    }
+    V* value = probation_.get(key);
+    if (value == nullptr || protected_.capacity() == 0) {
+      return value;
+    }
+    // 晋升到保护段，保护段已满时先把它最旧的条目降级到试用段
+    V promoted = std::move(*value);
+    probation_.erase(key);
+    if (protected_.size() == protected_.capacity()) {
+      K demoted_key;
+      V demoted_value;
+      protected_.pop(demoted_key, demoted_value);
+      probation_.put(demoted_key, std::move(demoted_value));
+    }
+    protected_.put(key, std::move(promoted));
+    return protected_.peek(key);
+  }
+
+  template <typename Value>
+  void putValue(const K& key, Value&& value) {
+    if (cap_ == 0) {
+      return;
+    }
+    sketch_.increment(key);
+    if (V* found = find(key)) {
+      // key 已存在，更新
+      *found = std::forward<Value>(value);
+      return;
+    }
+    // key 不存在，加入窗口，窗口已满时先处理窗口的逐出条目
+    if (window_.size() == window_.capacity()) {
+      K candidate_key;
+      V candidate_value;
+      window_.pop(candidate_key, candidate_value);
+      admit(candidate_key, std::move(candidate_value));
+    }
+    window_.put(key, std::forward<Value>(value));
+  }
+
+  // 决定窗口的逐出条目能否进入主区域
+  void admit(const K& key, V&& value) {
+    size_t main_capacity = probation_.capacity();
+    if (main_capacity == 0) {
+      return;
+    }
+    if (probation_.size() + protected_.size() < main_capacity) {
+      // 主区域未满，直接进入试用段
+      probation_.put(key, std::move(value));
+      return;
+    }
+    // 主区域已满（此时试用段一定不为空），与试用段的逐出条目比较估计频率
+    const K* victim = probation_.victim();
+    if (sketch_.estimate(key) > sketch_.estimate(*victim)) {
+      K victim_key;
+      V victim_value;
+      probation_.pop(victim_key, victim_value);
+      probation_.put(key, std::move(value));
+    }
+  }
+
+  size_t cap_;
+  BasicLRUCache<K, V, Hash> window_;
+  // 试用段的容量为整个主区域，保证降级时不会被 BasicLRUCache 自动逐出
+  // 主区域的总大小由 admit 控制
+  BasicLRUCache<K, V, Hash> probation_;
+  BasicLRUCache<K, V, Hash> protected_;
+  FrequencySketch<K, Hash> sketch_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // TINY_LFU_CACHE_H
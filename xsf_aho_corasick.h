@@ -0,0 +1,251 @@
+#ifndef XSF_AHO_CORASICK_H
+#define XSF_AHO_CORASICK_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "xsf_trie_map.h"
+#include "xsf_trie_set.h"
+
+namespace xsf_data_structures {
+
+// Aho-Corasick 多模式匹配自动机，由 XSFTrieMap、XSFTrieSet 中的所有键编译而来
+// 只需扫描一遍文本就能找出所有模式串的所有出现位置，耗时与模式串个数无关
+// 状态按 BFS 顺序编号，存储在扁平的数组中：
+// 1. 转移边以 CSR 格式存储，状态 s 的边是 [edge_begin_[s], edge_begin_[s + 1])
+// 2. fail_[s] 是失配指针，指向 s 对应字符串的最长真后缀所在的状态
+// 3. output_[s] 是 s 本身对应的模式串，dict_[s] 沿失配指针指向下一个有输出的状态
+// 根节点的转移单独用 256 项的数组存储，文本中的大部分字节都在根节点附近转移
+// 空字符串不作为模式串
+template <typename V>
+class XSFAhoCorasick {
+ private:
+  static constexpr uint32_t kNone_{UINT32_MAX};
+
+ public:
+  // 跨多个缓冲区流式扫描时，保存扫描的进度
+  struct ScanState {
+    uint32_t state{0};    // 自动机的当前状态
+    size_t position{0};   // 已扫描的字节数
+  };
+
+  XSFAhoCorasick() { Build(std::vector<std::pair<std::string, V>>()); }
+
+  // 编译，替换当前内容
+  template <class Alphabet>
+  void Build(const XSFTrieMap<V, Alphabet>& trie) {
+    std::vector<std::pair<std::string, V>> patterns;
+    patterns.reserve(trie.Size());
+    trie.ForEach([&patterns](const std::string& key, const V& value) {
+      patterns.emplace_back(key, value);
+    });
+    Build(std::move(patterns));
+  }
+
+  // 由集合编译时，每个模式串的值都是 V{}
+  void Build(const XSFTrieSet& set) {
+    std::vector<std::pair<std::string, V>> patterns;
+    patterns.reserve(set.Size());
+    set.ForEach([&patterns](const std::string& key) {
+      patterns.emplace_back(key, V{});
+    });
+    Build(std::move(patterns));
+  }
+
+  // 扫描 data[0..n)，对每次匹配调用 visitor(begin, length, value)
+  // begin 是匹配在文本中的起始位置，匹配按结束位置递增的顺序报告
+  // 返回匹配的次数
+  template <typename Visitor>
+  size_t Scan(const char* data, size_t n, Visitor&& visitor) const {
+    ScanState state;
+    return Scan(state, data, n, visitor);
+  }
+
+  template <typename Visitor>
+  size_t Scan(const std::string& text, Visitor&& visitor) const {
+    ScanState state;
+    return Scan(state, text.data(), text.size(), visitor);
+  }
+
+  // 从 state 处继续扫描下一个缓冲区 data[0..n)，跨越缓冲区边界的匹配也能找到
+  // begin 是相对于整个流的位置
+  template <typename Visitor>
+  size_t Scan(ScanState& state, const char* data, size_t n,
+              Visitor&& visitor) const {
+    size_t count = 0;
+    uint32_t s = state.state;
+    for (size_t i = 0; i < n; i++) {
+      s = Next(s, static_cast<uint8_t>(data[i]));
+      // 沿输出链报告以当前字节结尾的所有模式串
+      uint32_t u = output_[s] != kNone_ ? s : dict_[s];
+      while (u != kNone_) {
+        uint32_t p = output_[u];
+        size_t end = state.position + i + 1;
+        visitor(end - lengths_[p], static_cast<size_t>(lengths_[p]),
+                static_cast<const V&>(values_[p]));
+        count++;
+        u = dict_[u];
+      }
+    }
+    state.state = s;
+    state.position += n;
+    return count;
+  }
+
+  // 文本中是否出现了任意一个模式串
+  bool ContainsAny(const std::string& text) const {
+    uint32_t s = 0;
+    for (char c : text) {
+      s = Next(s, static_cast<uint8_t>(c));
+      if (output_[s] != kNone_ || dict_[s] != kNone_) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // 工具函数
+  // 模式串的个数
+  size_t Size() const { return values_.size(); }
+
+  bool Empty() const { return values_.empty(); }
+
+  // 自动机的状态个数
+  size_t StateCount() const { return fail_.size(); }
+
+ private:
+  // 状态 s 读入字节 c 后的状态，沿失配指针回退直到存在转移或到达根节点
+  uint32_t Next(uint32_t s, uint8_t c) const {
+    while (s != 0) {
+      uint32_t t = Goto(s, c);
+      if (t != kNone_) {
+        return t;
+      }
+      s = fail_[s];
+    }
+    return root_next_[c];
+  }
+
+  // 在 CSR 中二分查找状态 s（非根节点）经过字节 c 的转移，不存在时返回 kNone_
+  uint32_t Goto(uint32_t s, uint8_t c) const {
+    const uint8_t* first = edge_labels_.data() + edge_begin_[s];
+    const uint8_t* last = edge_labels_.data() + edge_begin_[s + 1];
+    const uint8_t* it = std::lower_bound(first, last, c);
+    if (it == last || *it != c) {
+      return kNone_;
+    }
+    return edge_targets_[it - edge_labels_.data()];
+  }
+
+  void Build(std::vector<std::pair<std::string, V>>&& patterns) {
+    // 按无符号字节的字典序排列，插入时同一节点的子节点按字节递增出现
+    std::sort(patterns.begin(), patterns.end(),
+              [](const std::pair<std::string, V>& a,
+                 const std::pair<std::string, V>& b) {
+                return a.first < b.first;
+              });
+    patterns.erase(
+        std::remove_if(patterns.begin(), patterns.end(),
+                       [](const std::pair<std::string, V>& pattern) {
+                         return pattern.first.empty();
+                       }),
+        patterns.end());
+
+    // 1. 构建临时的 Trie，children[s] 按字节递增排列
+    // 键已排序，与上一个键的公共前缀之后的子节点总是追加在末尾
+    std::vector<std::vector<std::pair<uint8_t, uint32_t>>> children(1);
+    std::vector<uint32_t> output(1, kNone_);
+    for (size_t p = 0; p < patterns.size(); p++) {
+      uint32_t s = 0;
+      for (char ch : patterns[p].first) {
+        uint8_t c = static_cast<uint8_t>(ch);
+        if (!children[s].empty() && children[s].back().first == c) {
+          s = children[s].back().second;
+        } else {
+          uint32_t t = static_cast<uint32_t>(children.size());
+          children[s].emplace_back(c, t);
+          children.emplace_back();
+          output.push_back(kNone_);
+          s = t;
+        }
+      }
+      output[s] = static_cast<uint32_t>(p);
+    }
+
+    // 2. 按 BFS 顺序重新编号，生成 CSR 格式的转移边
+    size_t n = children.size();
+    std::vector<uint32_t> order;  // order[i] 是新编号为 i 的旧状态
+    std::vector<uint32_t> renumber(n);
+    order.reserve(n);
+    order.push_back(0);
+    renumber[0] = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+      for (const auto& [c, t] : children[order[i]]) {
+        renumber[t] = static_cast<uint32_t>(order.size());
+        order.push_back(t);
+      }
+    }
+    edge_begin_.assign(n + 1, 0);
+    edge_labels_.clear();
+    edge_targets_.clear();
+    edge_labels_.reserve(n - 1);
+    edge_targets_.reserve(n - 1);
+    output_.assign(n, kNone_);
+    for (size_t i = 0; i < n; i++) {
+      edge_begin_[i] = static_cast<uint32_t>(edge_labels_.size());
+      for (const auto& [c, t] : children[order[i]]) {
+        edge_labels_.push_back(c);
+        edge_targets_.push_back(renumber[t]);
+      }
+      output_[i] = output[order[i]];
+    }
+    edge_begin_[n] = static_cast<uint32_t>(edge_labels_.size());
+    for (size_t c = 0; c < 256; c++) {
+      root_next_[c] = 0;
+    }
+    for (uint32_t e = edge_begin_[0]; e < edge_begin_[1]; e++) {
+      root_next_[edge_labels_[e]] = edge_targets_[e];
+    }
+
+    // 3. 按 BFS 顺序计算失配指针和输出链，父状态总是先于子状态处理
+    fail_.assign(n, 0);
+    dict_.assign(n, kNone_);
+    for (uint32_t s = 0; s < n; s++) {
+      for (uint32_t e = edge_begin_[s]; e < edge_begin_[s + 1]; e++) {
+        uint32_t t = edge_targets_[e];
+        fail_[t] = s == 0 ? 0 : Next(fail_[s], edge_labels_[e]);
+        uint32_t f = fail_[t];
+        dict_[t] = output_[f] != kNone_ ? f : dict_[f];
+      }
+    }
+
+    lengths_.clear();
+    values_.clear();
+    lengths_.reserve(patterns.size());
+    values_.reserve(patterns.size());
+    for (auto& [key, value] : patterns) {
+      lengths_.push_back(static_cast<uint32_t>(key.size()));
+      values_.push_back(std::move(value));
+    }
+  }
+
+  uint32_t root_next_[256];
+  std::vector<uint32_t> edge_begin_;
+  std::vector<uint8_t> edge_labels_;
+  std::vector<uint32_t> edge_targets_;
+  std::vector<uint32_t> fail_;
+  std::vector<uint32_t> output_;
+  std::vector<uint32_t> dict_;
+
+  // 第 p 个模式串的长度和值
+  std::vector<uint32_t> lengths_;
+  std::vector<V> values_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_AHO_CORASICK_H
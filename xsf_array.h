@@ -1,6 +1,8 @@
 #ifndef XSF_ARRAY_H
 #define XSF_ARRAY_H
 
+#include <cstddef>
+
 namespace xsf_data_structures {
 
 template <typename T, size_t S>
@@ -8,11 +10,11 @@ class XSFArray {
  public:
   constexpr size_t Size() const { return S; }
 
-  T &operator[](size_t index) { return data_[index]; }
-  const T &operator[](size_t index) const { return data_[index]; }
+  constexpr T &operator[](size_t index) { return data_[index]; }
+  constexpr const T &operator[](size_t index) const { return data_[index]; }
 
-  T *Data() { return data_; }
-  const T *Data() const { return data_; }
+  constexpr T *Data() { return data_; }
+  constexpr const T *Data() const { return data_; }
 
  private:
   T data_[S];
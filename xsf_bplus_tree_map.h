@@ -0,0 +1,600 @@
+#ifndef XSF_BPLUS_TREE_MAP_H
+#define XSF_BPLUS_TREE_MAP_H
+
+#include <cstddef>
+#include <list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xsf_data_structures {
+
+// 以 B+ 树为底层实现的 map，接口与 XSFTreeMap 保持一致
+// 每个节点最多存储 Capacity 个键，键在节点内连续存放，使用无分支二分查找
+// 所有键值对都存储在叶子节点中，叶子节点之间以双链表相连，范围查询即顺序遍历叶子
+// 内部节点记录每棵子树的键的个数，Rank、Select 的复杂度为 O(logN)
+template <typename K, typename V, class Compare, size_t Capacity = 64>
+class XSFBPlusTreeMap {
+  static_assert(Capacity >= 4, "node capacity must be at least 4");
+
+ private:
+  // 非根节点至少存储 kMinKeys_ 个键
+  static const size_t kMinKeys_{(Capacity - 1) / 2};
+
+  struct Node {
+    bool leaf;
+    size_t n{0};  // 节点中键的个数
+    K keys[Capacity];
+
+    explicit Node(bool l) : leaf(l) {}
+  };
+
+  struct Leaf : Node {
+    V values[Capacity];
+    Leaf* prev{nullptr};
+    Leaf* next{nullptr};
+
+    Leaf() : Node(true) {}
+  };
+
+  // keys[i] 是子树 children[i] 与 children[i + 1] 的分隔键
+  // children[i] 中的键都小于 keys[i]，children[i + 1] 中的键都大于等于 keys[i]
+  struct Inner : Node {
+    Node* children[Capacity + 1];
+    // counts[i] 记录子树 children[i] 中键的个数
+    size_t counts[Capacity + 1];
+
+    Inner() : Node(false) {}
+  };
+
+ public:
+  XSFBPlusTreeMap() = default;
+
+  XSFBPlusTreeMap(const XSFBPlusTreeMap&) = delete;
+  XSFBPlusTreeMap& operator=(const XSFBPlusTreeMap&) = delete;
+
+  ~XSFBPlusTreeMap() { Clear(); }
+
+  // 增、改
+  V& operator[](const K& key) { return InsertKey(key); }
+
+  V& operator[](K&& key) { return InsertKey(std::move(key)); }
+
+  // 删
+  void Erase(const K& key) {
+    Leaf* leaf;
+    size_t index;
+    if (!Find(key, leaf, index)) {
+      return;
+    }
+
+    // 自顶向下删除，进入子节点前保证其键的个数大于 kMinKeys_
+    Node* node = root_;
+    while (!node->leaf) {
+      Inner* inner = static_cast<Inner*>(node);
+      size_t c = UpperBound(inner->keys, inner->n, key);
+      if (inner->children[c]->n <= kMinKeys_) {
+        c = FixChild(inner, c);
+      }
+      inner->counts[c]--;
+      node = inner->children[c];
+    }
+    leaf = static_cast<Leaf*>(node);
+    index = LowerBound(leaf->keys, leaf->n, key);
+    for (size_t i = index + 1; i < leaf->n; i++) {
+      leaf->keys[i - 1] = std::move(leaf->keys[i]);
+      leaf->values[i - 1] = std::move(leaf->values[i]);
+    }
+    leaf->n--;
+    leaf->keys[leaf->n] = K{};
+    leaf->values[leaf->n] = V{};
+    size_--;
+
+    // 根节点的子节点合并后，根节点可能已经没有键了
+    while (!root_->leaf && root_->n == 0) {
+      Inner* old_root = static_cast<Inner*>(root_);
+      root_ = old_root->children[0];
+      delete old_root;
+    }
+    if (root_->leaf && root_->n == 0) {
+      delete static_cast<Leaf*>(root_);
+      root_ = nullptr;
+    }
+  }
+
+  void EraseMin() {
+    if (!Empty()) {
+      // 删除过程中节点内的键会移动，需要先复制一份
+      K key = FirstLeaf()->keys[0];
+      Erase(key);
+    }
+  }
+
+  void EraseMax() {
+    if (!Empty()) {
+      Leaf* leaf = LastLeaf();
+      K key = leaf->keys[leaf->n - 1];
+      Erase(key);
+    }
+  }
+
+  void Clear() {
+    Clear(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  // 查
+  bool Contains(const K& key) const {
+    Leaf* leaf;
+    size_t index;
+    return Find(key, leaf, index);
+  }
+
+  // 查找小于等于 key 的最大的键，如果不存在则返回 false
+  bool Floor(const K& key, K& result) const {
+    Leaf* leaf = FindLeaf(key);
+    if (leaf == nullptr) {
+      return false;
+    }
+    size_t index = UpperBound(leaf->keys, leaf->n, key);
+    if (index > 0) {
+      result = leaf->keys[index - 1];
+      return true;
+    }
+    // 叶子中的键都大于 key，答案在前一个叶子的末尾
+    if (leaf->prev == nullptr) {
+      return false;
+    }
+    result = leaf->prev->keys[leaf->prev->n - 1];
+    return true;
+  }
+
+  // 查找大于等于 key 的最小的键
+  bool Ceiling(const K& key, K& result) const {
+    Leaf* leaf = FindLeaf(key);
+    if (leaf == nullptr) {
+      return false;
+    }
+    size_t index = LowerBound(leaf->keys, leaf->n, key);
+    if (index < leaf->n) {
+      result = leaf->keys[index];
+      return true;
+    }
+    // 叶子中的键都小于 key，答案在后一个叶子的开头
+    if (leaf->next == nullptr) {
+      return false;
+    }
+    result = leaf->next->keys[0];
+    return true;
+  }
+
+  // 返回小于 key 的键的个数
+  size_t Rank(const K& key) const {
+    if (root_ == nullptr) {
+      return 0;
+    }
+    size_t rank = 0;
+    Node* node = root_;
+    while (!node->leaf) {
+      Inner* inner = static_cast<Inner*>(node);
+      size_t c = UpperBound(inner->keys, inner->n, key);
+      // 左边的子树中的键都小于 key
+      for (size_t i = 0; i < c; i++) {
+        rank += inner->counts[i];
+      }
+      node = inner->children[c];
+    }
+    return rank + LowerBound(node->keys, node->n, key);
+  }
+
+  // 返回索引为 i 的键，i 从 0 开始计算
+  K Select(size_t i) const {
+    if (i >= Size()) {
+      throw std::out_of_range("Index out of range");
+    }
+    Node* node = root_;
+    while (!node->leaf) {
+      Inner* inner = static_cast<Inner*>(node);
+      size_t c = 0;
+      while (i >= inner->counts[c]) {
+        i -= inner->counts[c];
+        c++;
+      }
+      node = inner->children[c];
+    }
+    return node->keys[i];
+  }
+
+  // 工具函数
+  size_t Size() const { return size_; }
+
+  bool Empty() const { return size_ == 0; }
+
+  // 从小到大返回所有键
+  std::vector<K> Keys() const {
+    std::vector<K> keys;
+    keys.reserve(size_);
+    for (Leaf* leaf = FirstLeaf(); leaf != nullptr; leaf = leaf->next) {
+      for (size_t i = 0; i < leaf->n; i++) {
+        keys.push_back(leaf->keys[i]);
+      }
+    }
+    return keys;
+  }
+
+  // 从小到大返回闭区间 [min, max] 中的键，沿叶子链表顺序扫描
+  std::list<K> Keys(const K& min, const K& max) const {
+    std::list<K> keys;
+    Leaf* leaf = FindLeaf(min);
+    if (leaf == nullptr) {
+      return keys;
+    }
+    size_t i = LowerBound(leaf->keys, leaf->n, min);
+    for (; leaf != nullptr; leaf = leaf->next, i = 0) {
+      for (; i < leaf->n; i++) {
+        if (compare_(max, leaf->keys[i])) {
+          // 超出 max
+          return keys;
+        }
+        keys.push_back(leaf->keys[i]);
+      }
+    }
+    return keys;
+  }
+
+ private:
+  // 返回 keys[0..n) 中第一个不小于 key 的位置（无分支二分查找）
+  size_t LowerBound(const K* keys, size_t n, const K& key) const {
+    if (n == 0) {
+      return 0;
+    }
+    const K* base = keys;
+    while (n > 1) {
+      size_t half = n / 2;
+      // 编译器会将其编译为条件传送指令，避免分支预测失败
+      base = compare_(base[half], key) ? base + half : base;
+      n -= half;
+    }
+    return (base - keys) + compare_(*base, key);
+  }
+
+  // 返回 keys[0..n) 中第一个大于 key 的位置（无分支二分查找）
+  size_t UpperBound(const K* keys, size_t n, const K& key) const {
+    if (n == 0) {
+      return 0;
+    }
+    const K* base = keys;
+    while (n > 1) {
+      size_t half = n / 2;
+      base = compare_(key, base[half]) ? base : base + half;
+      n -= half;
+    }
+    return (base - keys) + !compare_(key, *base);
+  }
+
+  // 找到 key 所在（或应该在）的叶子节点，树为空时返回 null
+  Leaf* FindLeaf(const K& key) const {
+    Node* node = root_;
+    if (node == nullptr) {
+      return nullptr;
+    }
+    while (!node->leaf) {
+      Inner* inner = static_cast<Inner*>(node);
+      node = inner->children[UpperBound(inner->keys, inner->n, key)];
+    }
+    return static_cast<Leaf*>(node);
+  }
+
+  bool Find(const K& key, Leaf*& leaf, size_t& index) const {
+    leaf = FindLeaf(key);
+    if (leaf == nullptr) {
+      return false;
+    }
+    index = LowerBound(leaf->keys, leaf->n, key);
+    return index < leaf->n && !compare_(key, leaf->keys[index]);
+  }
+
+  Leaf* FirstLeaf() const {
+    Node* node = root_;
+    if (node == nullptr) {
+      return nullptr;
+    }
+    while (!node->leaf) {
+      node = static_cast<Inner*>(node)->children[0];
+    }
+    return static_cast<Leaf*>(node);
+  }
+
+  Leaf* LastLeaf() const {
+    Node* node = root_;
+    if (node == nullptr) {
+      return nullptr;
+    }
+    while (!node->leaf) {
+      node = static_cast<Inner*>(node)->children[node->n];
+    }
+    return static_cast<Leaf*>(node);
+  }
+
+  // 插入 key（若不存在），返回对应 value 的引用
+  template <typename KeyType>
+  V& InsertKey(KeyType&& key) {
+    Leaf* leaf;
+    size_t index;
+    if (Find(key, leaf, index)) {
+      return leaf->values[index];
+    }
+
+    if (root_ == nullptr) {
+      root_ = new Leaf();
+    }
+    if (root_->n == Capacity) {
+      // 根节点已满，树长高一层
+      Inner* new_root = new Inner();
+      new_root->children[0] = root_;
+      new_root->counts[0] = size_;
+      SplitChild(new_root, 0);
+      root_ = new_root;
+    }
+
+    // 自顶向下插入，进入子节点前保证其未满，分裂不会向上传播
+    Node* node = root_;
+    while (!node->leaf) {
+      Inner* inner = static_cast<Inner*>(node);
+      size_t c = UpperBound(inner->keys, inner->n, key);
+      if (inner->children[c]->n == Capacity) {
+        SplitChild(inner, c);
+        if (!compare_(key, inner->keys[c])) {
+          c++;
+        }
+      }
+      inner->counts[c]++;
+      node = inner->children[c];
+    }
+    leaf = static_cast<Leaf*>(node);
+    index = LowerBound(leaf->keys, leaf->n, key);
+    for (size_t i = leaf->n; i > index; i--) {
+      leaf->keys[i] = std::move(leaf->keys[i - 1]);
+      leaf->values[i] = std::move(leaf->values[i - 1]);
+    }
+    leaf->keys[index] = std::forward<KeyType>(key);
+    leaf->values[index] = V{};
+    leaf->n++;
+    size_++;
+    return leaf->values[index];
+  }
+
+  // 将已满的子节点 parent->children[c] 分裂为两个节点
+  void SplitChild(Inner* parent, size_t c) {
+    Node* child = parent->children[c];
+    size_t mid = Capacity / 2;
+    K separator;
+    Node* right;
+    size_t left_count;
+    size_t right_count;
+
+    if (child->leaf) {
+      // 叶子节点：后一半键值对移入新叶子，分隔键为新叶子的第一个键
+      Leaf* left_leaf = static_cast<Leaf*>(child);
+      Leaf* right_leaf = new Leaf();
+      for (size_t i = mid; i < Capacity; i++) {
+        right_leaf->keys[i - mid] = std::move(left_leaf->keys[i]);
+        right_leaf->values[i - mid] = std::move(left_leaf->values[i]);
+      }
+      right_leaf->n = Capacity - mid;
+      left_leaf->n = mid;
+      // 链接叶子链表
+      right_leaf->next = left_leaf->next;
+      right_leaf->prev = left_leaf;
+      if (left_leaf->next != nullptr) {
+        left_leaf->next->prev = right_leaf;
+      }
+      left_leaf->next = right_leaf;
+      separator = right_leaf->keys[0];
+      left_count = left_leaf->n;
+      right_count = right_leaf->n;
+      right = right_leaf;
+    } else {
+      // 内部节点：中间的键上移到父节点，后一半键和子节点移入新节点
+      Inner* left_inner = static_cast<Inner*>(child);
+      Inner* right_inner = new Inner();
+      separator = std::move(left_inner->keys[mid]);
+      for (size_t i = mid + 1; i < Capacity; i++) {
+        right_inner->keys[i - mid - 1] = std::move(left_inner->keys[i]);
+      }
+      left_count = 0;
+      right_count = 0;
+      for (size_t i = 0; i <= Capacity; i++) {
+        if (i <= mid) {
+          left_count += left_inner->counts[i];
+        } else {
+          right_inner->children[i - mid - 1] = left_inner->children[i];
+          right_inner->counts[i - mid - 1] = left_inner->counts[i];
+          right_count += left_inner->counts[i];
+        }
+      }
+      right_inner->n = Capacity - mid - 1;
+      left_inner->n = mid;
+      right = right_inner;
+    }
+
+    // 在父节点的 c 位置插入分隔键和新节点
+    for (size_t i = parent->n; i > c; i--) {
+      parent->keys[i] = std::move(parent->keys[i - 1]);
+      parent->children[i + 1] = parent->children[i];
+      parent->counts[i + 1] = parent->counts[i];
+    }
+    parent->keys[c] = std::move(separator);
+    parent->children[c + 1] = right;
+    parent->counts[c] = left_count;
+    parent->counts[c + 1] = right_count;
+    parent->n++;
+  }
+
+  // parent->children[c] 中只有 kMinKeys_ 个键，从兄弟节点借一个键或与兄弟节点合并
+  // 返回调整后原子节点中的键所在的子节点索引
+  size_t FixChild(Inner* parent, size_t c) {
+    if (c > 0 && parent->children[c - 1]->n > kMinKeys_) {
+      BorrowFromLeft(parent, c);
+      return c;
+    }
+    if (c < parent->n && parent->children[c + 1]->n > kMinKeys_) {
+      BorrowFromRight(parent, c);
+      return c;
+    }
+    if (c > 0) {
+      Merge(parent, c - 1);
+      return c - 1;
+    }
+    Merge(parent, c);
+    return c;
+  }
+
+  // parent->children[c] 从左兄弟借一个键
+  void BorrowFromLeft(Inner* parent, size_t c) {
+    Node* left = parent->children[c - 1];
+    Node* child = parent->children[c];
+    size_t moved;
+
+    for (size_t i = child->n; i > 0; i--) {
+      child->keys[i] = std::move(child->keys[i - 1]);
+    }
+    if (child->leaf) {
+      Leaf* left_leaf = static_cast<Leaf*>(left);
+      Leaf* child_leaf = static_cast<Leaf*>(child);
+      for (size_t i = child->n; i > 0; i--) {
+        child_leaf->values[i] = std::move(child_leaf->values[i - 1]);
+      }
+      child_leaf->keys[0] = std::move(left_leaf->keys[left->n - 1]);
+      child_leaf->values[0] = std::move(left_leaf->values[left->n - 1]);
+      parent->keys[c - 1] = child_leaf->keys[0];
+      moved = 1;
+    } else {
+      Inner* left_inner = static_cast<Inner*>(left);
+      Inner* child_inner = static_cast<Inner*>(child);
+      for (size_t i = child->n + 1; i > 0; i--) {
+        child_inner->children[i] = child_inner->children[i - 1];
+        child_inner->counts[i] = child_inner->counts[i - 1];
+      }
+      // 父节点的分隔键下移，左兄弟的最后一个键上移
+      child_inner->keys[0] = std::move(parent->keys[c - 1]);
+      child_inner->children[0] = left_inner->children[left->n];
+      child_inner->counts[0] = left_inner->counts[left->n];
+      parent->keys[c - 1] = std::move(left_inner->keys[left->n - 1]);
+      moved = child_inner->counts[0];
+    }
+    left->n--;
+    child->n++;
+    parent->counts[c - 1] -= moved;
+    parent->counts[c] += moved;
+  }
+
+  // parent->children[c] 从右兄弟借一个键
+  void BorrowFromRight(Inner* parent, size_t c) {
+    Node* child = parent->children[c];
+    Node* right = parent->children[c + 1];
+    size_t moved;
+
+    if (child->leaf) {
+      Leaf* child_leaf = static_cast<Leaf*>(child);
+      Leaf* right_leaf = static_cast<Leaf*>(right);
+      child_leaf->keys[child->n] = std::move(right_leaf->keys[0]);
+      child_leaf->values[child->n] = std::move(right_leaf->values[0]);
+      for (size_t i = 1; i < right->n; i++) {
+        right_leaf->keys[i - 1] = std::move(right_leaf->keys[i]);
+        right_leaf->values[i - 1] = std::move(right_leaf->values[i]);
+      }
+      parent->keys[c] = right_leaf->keys[0];
+      moved = 1;
+    } else {
+      Inner* child_inner = static_cast<Inner*>(child);
+      Inner* right_inner = static_cast<Inner*>(right);
+      // 父节点的分隔键下移，右兄弟的第一个键上移
+      child_inner->keys[child->n] = std::move(parent->keys[c]);
+      child_inner->children[child->n + 1] = right_inner->children[0];
+      child_inner->counts[child->n + 1] = right_inner->counts[0];
+      moved = right_inner->counts[0];
+      parent->keys[c] = std::move(right_inner->keys[0]);
+      for (size_t i = 1; i < right->n; i++) {
+        right_inner->keys[i - 1] = std::move(right_inner->keys[i]);
+      }
+      for (size_t i = 1; i <= right->n; i++) {
+        right_inner->children[i - 1] = right_inner->children[i];
+        right_inner->counts[i - 1] = right_inner->counts[i];
+      }
+    }
+    child->n++;
+    right->n--;
+    parent->counts[c] += moved;
+    parent->counts[c + 1] -= moved;
+  }
+
+  // 将 parent->children[i + 1] 合并到 parent->children[i] 中
+  void Merge(Inner* parent, size_t i) {
+    Node* left = parent->children[i];
+    Node* right = parent->children[i + 1];
+
+    if (left->leaf) {
+      Leaf* left_leaf = static_cast<Leaf*>(left);
+      Leaf* right_leaf = static_cast<Leaf*>(right);
+      for (size_t j = 0; j < right->n; j++) {
+        left_leaf->keys[left->n + j] = std::move(right_leaf->keys[j]);
+        left_leaf->values[left->n + j] = std::move(right_leaf->values[j]);
+      }
+      left->n += right->n;
+      left_leaf->next = right_leaf->next;
+      if (right_leaf->next != nullptr) {
+        right_leaf->next->prev = left_leaf;
+      }
+      delete right_leaf;
+    } else {
+      Inner* left_inner = static_cast<Inner*>(left);
+      Inner* right_inner = static_cast<Inner*>(right);
+      // 父节点的分隔键下移到合并后的节点中
+      left_inner->keys[left->n] = std::move(parent->keys[i]);
+      for (size_t j = 0; j < right->n; j++) {
+        left_inner->keys[left->n + 1 + j] = std::move(right_inner->keys[j]);
+      }
+      for (size_t j = 0; j <= right->n; j++) {
+        left_inner->children[left->n + 1 + j] = right_inner->children[j];
+        left_inner->counts[left->n + 1 + j] = right_inner->counts[j];
+      }
+      left->n += 1 + right->n;
+      delete right_inner;
+    }
+
+    // 从父节点中删除分隔键 keys[i] 和子节点 children[i + 1]
+    parent->counts[i] += parent->counts[i + 1];
+    for (size_t j = i + 1; j < parent->n; j++) {
+      parent->keys[j - 1] = std::move(parent->keys[j]);
+      parent->children[j] = parent->children[j + 1];
+      parent->counts[j] = parent->counts[j + 1];
+    }
+    parent->n--;
+  }
+
+  // 删除以 node 为根的 B+ 树
+  void Clear(Node* node) {
+    if (node == nullptr) {
+      return;
+    }
+    if (node->leaf) {
+      delete static_cast<Leaf*>(node);
+      return;
+    }
+    Inner* inner = static_cast<Inner*>(node);
+    for (size_t i = 0; i <= inner->n; i++) {
+      Clear(inner->children[i]);
+    }
+    delete inner;
+  }
+
+  Compare compare_{};
+  Node* root_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_BPLUS_TREE_MAP_H
@@ -0,0 +1,268 @@
+#ifndef XSF_CONCURRENT_SKIP_LIST_MAP_H
+#define XSF_CONCURRENT_SKIP_LIST_MAP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <utility>
+
+#include "xsf_epoch_reclaimer.h"
+
+namespace xsf_data_structures {
+
+// 并发有序映射，基于跳表，接口与 XSFTreeMap 的 Floor、Ceiling、区间查询一致
+// 读操作（查找、Floor、Ceiling、区间遍历）不加锁，多个读线程之间互不阻塞
+// 写操作（插入、更新、删除）之间由一把互斥锁串行化，但不会阻塞读线程
+// 被删除的节点和被替换的值交给 XSFEpochReclaimer，待读线程离开后再释放
+template <typename K, typename V, class Compare>
+class XSFConcurrentSkipListMap {
+ private:
+  struct Node {
+    const K key{};
+    // 值通过原子指针替换，读线程总能读到一个完整的值
+    std::atomic<V*> value{nullptr};
+    int level{0};
+    // next[i] 指向第 i 层的后继节点
+    std::atomic<Node*>* next{nullptr};
+
+    explicit Node(int l) : level(l), next(new std::atomic<Node*>[l]) {
+      for (int i = 0; i < l; i++) {
+        next[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    Node(const K& k, V* v, int l) : key(k), value(v), level(l) {
+      next = new std::atomic<Node*>[l];
+      for (int i = 0; i < l; i++) {
+        next[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    ~Node() {
+      delete value.load(std::memory_order_relaxed);
+      delete[] next;
+    }
+  };
+
+ public:
+  XSFConcurrentSkipListMap() : head_(new Node(kMaxLevel_)) {}
+
+  XSFConcurrentSkipListMap(const XSFConcurrentSkipListMap&) = delete;
+  XSFConcurrentSkipListMap& operator=(const XSFConcurrentSkipListMap&) = delete;
+
+  // 析构时不能有其他线程在访问
+  ~XSFConcurrentSkipListMap() {
+    Node* node = head_->next[0].load(std::memory_order_relaxed);
+    while (node != nullptr) {
+      Node* next = node->next[0].load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+    delete head_;
+  }
+
+  // 增、改，key 已存在时替换它的值
+  void Put(const K& key, const V& value) { PutValue(key, new V(value)); }
+
+  void Put(const K& key, V&& value) { PutValue(key, new V(std::move(value))); }
+
+  // 删，key 不存在时返回 false
+  bool Erase(const K& key) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Node* update[kMaxLevel_];
+    Node* node = FindPredecessors(key, update);
+    if (node == nullptr || compare_(key, node->key)) {
+      return false;
+    }
+    // 自顶向下摘除，第 0 层摘除后节点对新的读操作不再可见
+    for (int i = node->level - 1; i >= 0; i--) {
+      update[i]->next[i].store(node->next[i].load(std::memory_order_relaxed),
+                               std::memory_order_release);
+    }
+    while (level_ > 1 &&
+           head_->next[level_ - 1].load(std::memory_order_relaxed) == nullptr) {
+      level_--;
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    reclaimer_.Retire(node);
+    return true;
+  }
+
+  // 查，找到时把值复制到 result 中
+  bool Get(const K& key, V& result) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = Ceiling(key);
+    if (node == nullptr || compare_(key, node->key)) {
+      return false;
+    }
+    result = *node->value.load(std::memory_order_acquire);
+    return true;
+  }
+
+  bool Contains(const K& key) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = Ceiling(key);
+    return node != nullptr && !compare_(key, node->key);
+  }
+
+  // 查找小于等于 key 的最大的键
+  bool Floor(const K& key, K& result) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = Floor(key);
+    if (node == nullptr) {
+      return false;
+    }
+    result = node->key;
+    return true;
+  }
+
+  // 查找大于等于 key 的最小的键
+  bool Ceiling(const K& key, K& result) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = Ceiling(key);
+    if (node == nullptr) {
+      return false;
+    }
+    result = node->key;
+    return true;
+  }
+
+  // 从小到大遍历闭区间 [min, max] 中的键值对，visitor 返回 false 时提前结束
+  // 遍历期间持续处于读临界区，visitor 中不宜做耗时操作
+  // 遍历不是快照，可能看到遍历开始后其他线程插入、删除的键
+  template <typename Visitor>
+  void ForEach(const K& min, const K& max, Visitor&& visitor) const {
+    auto guard = reclaimer_.Enter();
+    for (Node* node = Ceiling(min);
+         node != nullptr && !compare_(max, node->key);
+         node = node->next[0].load(std::memory_order_acquire)) {
+      if (!visitor(node->key, *node->value.load(std::memory_order_acquire))) {
+        return;
+      }
+    }
+  }
+
+  // 从小到大返回闭区间 [min, max] 中的键
+  std::list<K> Keys(const K& min, const K& max) const {
+    std::list<K> keys;
+    ForEach(min, max, [&keys](const K& key, const V&) {
+      keys.push_back(key);
+      return true;
+    });
+    return keys;
+  }
+
+  // 工具函数，并发情况下只是一个瞬时值
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  bool Empty() const { return Size() == 0; }
+
+ private:
+  static const int kMaxLevel_{32};
+
+  void PutValue(const K& key, V* value) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Node* update[kMaxLevel_];
+    Node* node = FindPredecessors(key, update);
+    if (node != nullptr && !compare_(key, node->key)) {
+      // key 已存在，替换值，旧值可能仍在被读线程访问
+      V* old = node->value.exchange(value, std::memory_order_acq_rel);
+      reclaimer_.Retire(old);
+      return;
+    }
+
+    int level = RandomLevel();
+    if (level > level_) {
+      for (int i = level_; i < level; i++) {
+        update[i] = head_;
+      }
+      level_ = level;
+    }
+    node = new Node(key, value, level);
+    for (int i = 0; i < level; i++) {
+      node->next[i].store(update[i]->next[i].load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+    }
+    // 自底向上发布，读线程在第 0 层看到节点时节点已完整初始化
+    for (int i = 0; i < level; i++) {
+      update[i]->next[i].store(node, std::memory_order_release);
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // 记录每一层中最后一个小于 key 的节点，返回第 0 层中第一个大于等于 key 的节点
+  // 仅限持有写锁时调用
+  Node* FindPredecessors(const K& key, Node** update) const {
+    Node* x = head_;
+    for (int i = level_ - 1; i >= 0; i--) {
+      Node* next = x->next[i].load(std::memory_order_relaxed);
+      while (next != nullptr && compare_(next->key, key)) {
+        x = next;
+        next = x->next[i].load(std::memory_order_relaxed);
+      }
+      update[i] = x;
+    }
+    return x->next[0].load(std::memory_order_relaxed);
+  }
+
+  // 返回第一个大于等于 key 的节点，调用者需处于读临界区
+  // 读线程不读取 level_，总是从最高层开始查找，空的高层只需一次比较
+  // 返回的必须是第 0 层循环中读到的节点，再次读取 x->next[0] 可能读到新插入的更小的节点
+  Node* Ceiling(const K& key) const {
+    Node* x = head_;
+    Node* next = nullptr;
+    for (int i = kMaxLevel_ - 1; i >= 0; i--) {
+      next = x->next[i].load(std::memory_order_acquire);
+      while (next != nullptr && compare_(next->key, key)) {
+        x = next;
+        next = x->next[i].load(std::memory_order_acquire);
+      }
+    }
+    return next;
+  }
+
+  // 返回最后一个小于等于 key 的节点，调用者需处于读临界区
+  Node* Floor(const K& key) const {
+    Node* x = head_;
+    for (int i = kMaxLevel_ - 1; i >= 0; i--) {
+      Node* next = x->next[i].load(std::memory_order_acquire);
+      while (next != nullptr && !compare_(key, next->key)) {
+        x = next;
+        next = x->next[i].load(std::memory_order_acquire);
+      }
+    }
+    return x == head_ ? nullptr : x;
+  }
+
+  // 以 1/4 的概率逐层晋升，仅限持有写锁时调用
+  int RandomLevel() {
+    int level = 1;
+    // xorshift64
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 7;
+    seed_ ^= seed_ << 17;
+    uint64_t bits = seed_;
+    while (level < kMaxLevel_ && (bits & 3) == 0) {
+      level++;
+      bits >>= 2;
+    }
+    return level;
+  }
+
+  Node* head_;
+  std::atomic<size_t> size_{0};
+
+  // 以下成员仅由持有写锁的线程访问
+  std::mutex write_mutex_;
+  int level_{1};
+  uint64_t seed_{0x9E3779B97F4A7C15};
+
+  Compare compare_;
+  mutable XSFEpochReclaimer reclaimer_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_CONCURRENT_SKIP_LIST_MAP_H
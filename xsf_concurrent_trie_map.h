@@ -0,0 +1,449 @@
+#ifndef XSF_CONCURRENT_TRIE_MAP_H
+#define XSF_CONCURRENT_TRIE_MAP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "xsf_epoch_reclaimer.h"
+
+namespace xsf_data_structures {
+
+// 读多写少的并发前缀树，接口与 XSFTrieMap 的查询部分一致，采用 RCU（读-复制-更新）方式：
+// 1. 已发布的节点不再修改，读线程只需进入 XSFEpochReclaimer 的临界区，不加锁、不等待写线程
+// 2. 写线程之间由一把互斥锁串行化，修改时复制从根节点到目标节点的路径（path copying），
+//    其余子树与旧版本共享，最后原子地发布新的根节点
+// 3. 被替换的旧节点和旧值交给 XSFEpochReclaimer，待读线程离开后再释放
+// 每次读操作看到的都是某一个完整的版本（快照），不会看到修改了一半的树
+// 多个修改可以通过 Update 合并为一次发布，同一批修改中新建的节点直接原地修改，不再复制
+// 修改过程中抛出异常时撤销所有尚未发布的修改，已发布的版本不受影响
+// 子节点按字符从小到大存储在有序数组中，复制一个节点只需复制实际存在的子节点
+template <typename V>
+class XSFConcurrentTrieMap {
+ private:
+  struct Node {
+    // value 不归节点所有，复制节点时新旧节点共享同一个 value，由 map 单独回收
+    V* value{nullptr};
+    std::vector<std::pair<unsigned char, Node*>> children;
+    // 创建该节点的写版本，等于当前写版本的节点尚未发布，可以原地修改
+    uint64_t version{0};
+  };
+
+ public:
+  // 一批修改，由 Update 创建，所有修改在 Update 返回时一起发布
+  class Batch {
+   public:
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    void Put(const std::string& key, const V& value) {
+      map_->PutValue(key, new V(value));
+    }
+
+    void Put(const std::string& key, V&& value) {
+      map_->PutValue(key, new V(std::move(value)));
+    }
+
+    bool Erase(const std::string& key) { return map_->EraseKey(key); }
+
+   private:
+    friend class XSFConcurrentTrieMap;
+
+    explicit Batch(XSFConcurrentTrieMap* map) : map_(map) {}
+
+    XSFConcurrentTrieMap* map_;
+  };
+
+  XSFConcurrentTrieMap() = default;
+
+  XSFConcurrentTrieMap(const XSFConcurrentTrieMap&) = delete;
+  XSFConcurrentTrieMap& operator=(const XSFConcurrentTrieMap&) = delete;
+
+  // 析构时不能有其他线程在访问
+  ~XSFConcurrentTrieMap() { Clear(root_.load(std::memory_order_relaxed)); }
+
+  // 增、改，key 已存在时替换它的值
+  void Put(const std::string& key, const V& value) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Commit([&] { PutValue(key, new V(value)); });
+  }
+
+  void Put(const std::string& key, V&& value) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Commit([&] { PutValue(key, new V(std::move(value))); });
+  }
+
+  // 删，key 不存在时返回 false
+  bool Erase(const std::string& key) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    bool erased = false;
+    Commit([&] { erased = EraseKey(key); });
+    return erased;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Commit([&] {
+      Retire(next_root_);
+      next_root_ = nullptr;
+      size_.store(0, std::memory_order_relaxed);
+    });
+  }
+
+  // 批量修改，对一个 Batch 调用 f(batch)，f 返回后一次性发布所有修改
+  // 读线程要么看到全部修改，要么一个都看不到
+  // f 抛出异常时撤销本批的所有修改并重新抛出，读线程和之后的写线程都看不到它们
+  template <typename F>
+  void Update(F&& f) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    Commit([&] {
+      Batch batch(this);
+      f(batch);
+    });
+  }
+
+  // 查，找到时把值复制到 result 中
+  bool Get(const std::string& key, V& result) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = FindNode(root_.load(std::memory_order_acquire), key);
+    if (node == nullptr || node->value == nullptr) {
+      return false;
+    }
+    result = *node->value;
+    return true;
+  }
+
+  bool Contains(const std::string& key) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = FindNode(root_.load(std::memory_order_acquire), key);
+    return node != nullptr && node->value != nullptr;
+  }
+
+  // 在所有键中寻找 query 的最长前缀
+  std::string FindLongestPrefix(const std::string& query) const {
+    auto guard = reclaimer_.Enter();
+    size_t length = 0;
+    if (LongestPrefix(query, length) == nullptr) {
+      return "";
+    }
+    return query.substr(0, length);
+  }
+
+  // 最长前缀匹配（如路由表），把 query 的最长前缀对应的值复制到 result 中
+  // 不存在是 query 前缀的键时返回 false
+  bool GetLongestPrefix(const std::string& query, V& result) const {
+    auto guard = reclaimer_.Enter();
+    size_t length = 0;
+    Node* node = LongestPrefix(query, length);
+    if (node == nullptr) {
+      return false;
+    }
+    result = *node->value;
+    return true;
+  }
+
+  // 判断是否存在前缀为 prefix 的键
+  bool ContainsKeysWithPrefix(const std::string& prefix) const {
+    auto guard = reclaimer_.Enter();
+    return FindNode(root_.load(std::memory_order_acquire), prefix) != nullptr;
+  }
+
+  // 按字典序对前缀为 prefix 的键值对调用 visitor(key, value)，最多调用 limit 次
+  // 遍历的是调用开始时的快照，期间持续处于读临界区，visitor 中不宜做耗时操作
+  // 返回调用 visitor 的次数
+  template <typename Visitor>
+  size_t VisitKeysWithPrefix(const std::string& prefix, Visitor&& visitor,
+                             size_t limit = SIZE_MAX) const {
+    auto guard = reclaimer_.Enter();
+    Node* node = FindNode(root_.load(std::memory_order_acquire), prefix);
+    if (node == nullptr || limit == 0) {
+      return 0;
+    }
+    size_t count = 0;
+    std::string path = prefix;
+    if (node->value != nullptr) {
+      visitor(static_cast<const std::string&>(path),
+              static_cast<const V&>(*node->value));
+      if (++count == limit) {
+        return count;
+      }
+    }
+    // 显式栈，每一层记录节点和下一个待访问的子节点下标
+    std::vector<std::pair<Node*, size_t>> stack;
+    stack.emplace_back(node, 0);
+    while (!stack.empty()) {
+      auto& [parent, next] = stack.back();
+      if (next == parent->children.size()) {
+        // parent 的子节点已全部访问，回溯
+        stack.pop_back();
+        if (!stack.empty()) {
+          path.pop_back();
+        }
+        continue;
+      }
+      auto [c, child] = parent->children[next++];
+      path.push_back(static_cast<char>(c));
+      if (child->value != nullptr) {
+        visitor(static_cast<const std::string&>(path),
+                static_cast<const V&>(*child->value));
+        if (++count == limit) {
+          return count;
+        }
+      }
+      stack.emplace_back(child, 0);
+    }
+    return count;
+  }
+
+  // 按字典序对每个键值对调用 visitor(key, value)，遍历的是调用开始时的快照
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const {
+    VisitKeysWithPrefix("", visitor);
+  }
+
+  // 工具函数，并发情况下只是一个瞬时值
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  bool Empty() const { return Size() == 0; }
+
+ private:
+  // 在 node 的有序子节点数组中二分查找字符 c
+  static typename std::vector<std::pair<unsigned char, Node*>>::iterator
+  LowerBound(Node* node, unsigned char c) {
+    return std::lower_bound(
+        node->children.begin(), node->children.end(), c,
+        [](const std::pair<unsigned char, Node*>& child, unsigned char label) {
+          return child.first < label;
+        });
+  }
+
+  static Node* FindChild(Node* node, unsigned char c) {
+    auto it = LowerBound(node, c);
+    if (it == node->children.end() || it->first != c) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  // 从 node 开始搜索 key，如果存在返回对应节点，否则返回 null
+  static Node* FindNode(Node* node, const std::string& key) {
+    for (size_t i = 0; node != nullptr && i < key.size(); i++) {
+      node = FindChild(node, static_cast<unsigned char>(key[i]));
+    }
+    return node;
+  }
+
+  // 返回 query 的最长前缀对应的节点，length 为前缀的长度，调用者需处于读临界区
+  Node* LongestPrefix(const std::string& query, size_t& length) const {
+    Node* node = root_.load(std::memory_order_acquire);
+    Node* result = nullptr;
+    for (size_t i = 0; node != nullptr; i++) {
+      if (node->value != nullptr) {
+        result = node;
+        length = i;
+      }
+      if (i == query.size()) {
+        break;
+      }
+      node = FindChild(node, static_cast<unsigned char>(query[i]));
+    }
+    return result;
+  }
+
+  // 以下函数仅限持有写锁时调用
+
+  // 执行修改 f，成功时发布新版本，抛出异常时撤销所有尚未发布的修改后重新抛出
+  template <typename F>
+  void Commit(F&& f) {
+    size_t size = size_.load(std::memory_order_relaxed);
+    try {
+      f();
+    } catch (...) {
+      Rollback(size);
+      throw;
+    }
+    Publish();
+  }
+
+  // 丢弃正在构建的新版本，恢复到已发布的版本
+  // 本批新建的节点和值都没有发布，直接释放；被替换的已发布节点和值仍属于已发布的版本，不回收
+  void Rollback(size_t size) {
+    DiscardUnpublished(next_root_);
+    next_root_ = root_.load(std::memory_order_relaxed);
+    for (V* value : fresh_values_) {
+      delete value;
+    }
+    fresh_values_.clear();
+    retired_nodes_.clear();
+    retired_values_.clear();
+    size_.store(size, std::memory_order_relaxed);
+  }
+
+  // 释放以 node 为根的子树中尚未发布的节点
+  // 已发布的节点不会被修改，不可能指向尚未发布的节点，遇到时停止
+  void DiscardUnpublished(Node* node) {
+    if (node == nullptr || node->version != version_) {
+      return;
+    }
+    for (const auto& [c, child] : node->children) {
+      DiscardUnpublished(child);
+    }
+    delete node;
+  }
+
+  // 返回可以原地修改的 node：尚未发布的节点直接返回，已发布的节点复制一份
+  // 被复制的旧节点在发布后回收，node 为 null 时新建节点
+  Node* Writable(Node* node) {
+    if (node == nullptr) {
+      Node* fresh = new Node();
+      fresh->version = version_;
+      return fresh;
+    }
+    if (node->version == version_) {
+      return node;
+    }
+    // 先登记旧节点，复制失败时不会泄漏副本
+    retired_nodes_.push_back(node);
+    Node* copy = new Node(*node);
+    copy->version = version_;
+    return copy;
+  }
+
+  // 在新版本中插入或替换 key 的值，复制从根节点到 key 的路径，value 归 map 所有
+  void PutValue(const std::string& key, V* value) {
+    // 先登记新值，撤销时由 Rollback 释放
+    try {
+      fresh_values_.push_back(value);
+    } catch (...) {
+      delete value;
+      throw;
+    }
+    Node** ref = &next_root_;
+    for (size_t i = 0;; i++) {
+      Node* node = Writable(*ref);
+      *ref = node;
+      if (i == key.size()) {
+        if (node->value == nullptr) {
+          size_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          retired_values_.push_back(node->value);
+        }
+        node->value = value;
+        return;
+      }
+      unsigned char c = static_cast<unsigned char>(key[i]);
+      auto it = LowerBound(node, c);
+      if (it == node->children.end() || it->first != c) {
+        it = node->children.insert(it, {c, nullptr});
+      }
+      // node 尚未发布，只有当前写线程会修改它的 children，ref 在下一轮中保持有效
+      ref = &it->second;
+    }
+  }
+
+  // 在新版本中删除 key，key 不存在时返回 false
+  bool EraseKey(const std::string& key) {
+    Node* node = FindNode(next_root_, key);
+    if (node == nullptr || node->value == nullptr) {
+      return false;
+    }
+    EraseNode(next_root_, key, 0);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // 在 ref 指向的子树中删除 key[i..]（已保证 key 存在），ref 更新为新的根节点
+  // 既没有值也没有子节点的节点被清理，ref 置为 null
+  // 复制出的节点立即链接到新版本中，中途抛出异常时 Rollback 能找到并释放它们
+  void EraseNode(Node*& ref, const std::string& key, size_t i) {
+    Node* node = Writable(ref);
+    ref = node;
+    if (i == key.size()) {
+      retired_values_.push_back(node->value);
+      node->value = nullptr;
+    } else {
+      auto it = LowerBound(node, static_cast<unsigned char>(key[i]));
+      // 递归只修改子节点，node 的 children 不变，it 保持有效
+      EraseNode(it->second, key, i + 1);
+      if (it->second == nullptr) {
+        node->children.erase(it);
+      }
+    }
+    if (node->value == nullptr && node->children.empty()) {
+      // node 尚未发布，可以直接释放
+      delete node;
+      ref = nullptr;
+    }
+  }
+
+  // 回收以 node 为根的子树中的所有节点和值，尚未发布的节点直接释放
+  void Retire(Node* node) {
+    if (node == nullptr) {
+      return;
+    }
+    for (const auto& [c, child] : node->children) {
+      Retire(child);
+    }
+    if (node->value != nullptr) {
+      retired_values_.push_back(node->value);
+    }
+    if (node->version == version_) {
+      delete node;
+    } else {
+      retired_nodes_.push_back(node);
+    }
+  }
+
+  // 发布新版本，此后新进入的读线程只能看到新版本
+  // 旧节点和旧值必须在发布之后才交给回收器，否则回收器推进纪元时可能有读线程仍在访问旧版本
+  void Publish() {
+    root_.store(next_root_, std::memory_order_release);
+    for (Node* node : retired_nodes_) {
+      reclaimer_.Retire(node);
+    }
+    for (V* value : retired_values_) {
+      reclaimer_.Retire(value);
+    }
+    retired_nodes_.clear();
+    retired_values_.clear();
+    fresh_values_.clear();
+    version_++;
+  }
+
+  // 删除以 node 为根的子树，包括所有值，仅在析构时调用
+  void Clear(Node* node) {
+    if (node == nullptr) {
+      return;
+    }
+    for (const auto& [c, child] : node->children) {
+      Clear(child);
+    }
+    delete node->value;
+    delete node;
+  }
+
+  // 已发布的根节点，读线程只访问它
+  std::atomic<Node*> root_{nullptr};
+  std::atomic<size_t> size_{0};
+
+  // 以下成员仅由持有写锁的线程访问
+  std::mutex write_mutex_;
+  Node* next_root_{nullptr};  // 正在构建的新版本的根节点
+  uint64_t version_{1};       // 当前写版本，每次发布后加一
+  // 新版本不再引用、等待发布后回收的节点和值
+  std::vector<Node*> retired_nodes_;
+  std::vector<V*> retired_values_;
+  // 本批新建、尚未发布的值，撤销时释放
+  std::vector<V*> fresh_values_;
+
+  mutable XSFEpochReclaimer reclaimer_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_CONCURRENT_TRIE_MAP_H
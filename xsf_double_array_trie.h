@@ -0,0 +1,379 @@
+#ifndef XSF_DOUBLE_ARRAY_TRIE_H
+#define XSF_DOUBLE_ARRAY_TRIE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xsf_trie_map.h"
+#include "xsf_trie_set.h"
+
+namespace xsf_data_structures {
+
+// 只读的双数组 Trie，由 XSFTrieMap、XSFTrieSet 一次性构建（冻结）而来
+// 状态 s 经过字节 c 转移到 t = base[s] + c + 1，当且仅当 check[t] == s 时转移有效
+// 每个字节的查找只需读取两个相邻的数组元素，所有节点存放在一块连续内存中
+// 可以保存为文件，再通过 mmap 只读加载，多个进程共享同一份物理内存
+// 值直接按字节写入文件，因此 V 必须是可平凡复制的；mmap 加载仅支持 POSIX 系统
+template <typename V>
+class XSFDoubleArrayTrie {
+  static_assert(std::is_trivially_copyable_v<V>,
+                "V must be trivially copyable");
+
+ private:
+  // base、check 相邻存放，一次查找转移只访问一条缓存行
+  struct Unit {
+    int32_t base;
+    int32_t check;
+  };
+
+  // 文件格式：Header + Unit[unit_count] + 对齐填充 + V[value_count]
+  struct Header {
+    char magic[8];
+    uint64_t unit_count;
+    uint64_t value_count;
+    uint64_t value_size;
+  };
+
+  static constexpr char kMagic_[8] = {'X', 'S', 'F', 'D', 'A', 'T', '1', '\0'};
+  static const int32_t kFree_{-1};  // check 为 -1 表示该位置空闲
+  static const int32_t kRoot_{-2};  // 根节点的 check，不等于任何状态
+
+ public:
+  XSFDoubleArrayTrie() = default;
+
+  XSFDoubleArrayTrie(const XSFDoubleArrayTrie&) = delete;
+  XSFDoubleArrayTrie& operator=(const XSFDoubleArrayTrie&) = delete;
+
+  ~XSFDoubleArrayTrie() { Reset(); }
+
+  // 构建，替换当前内容
+  template <class Alphabet>
+  void Build(const XSFTrieMap<V, Alphabet>& trie) {
+    std::vector<std::pair<std::string, V>> entries;
+    entries.reserve(trie.Size());
+    trie.ForEach([&entries](const std::string& key, const V& value) {
+      entries.emplace_back(key, value);
+    });
+    Build(entries);
+  }
+
+  // 由集合构建时，每个键的值都是 V{}
+  void Build(const XSFTrieSet& set) {
+    std::vector<std::pair<std::string, V>> entries;
+    entries.reserve(set.Size());
+    set.ForEach([&entries](const std::string& key) {
+      entries.emplace_back(key, V{});
+    });
+    Build(entries);
+  }
+
+  // 保存到文件，失败时抛出异常
+  void Save(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+      throw std::runtime_error("cannot open file: " + path);
+    }
+    Header header;
+    std::memcpy(header.magic, kMagic_, sizeof(kMagic_));
+    header.unit_count = unit_count_;
+    header.value_count = value_count_;
+    header.value_size = sizeof(V);
+    size_t padding = ValueOffset(unit_count_) - sizeof(Header) -
+                     unit_count_ * sizeof(Unit);
+    const char zeros[alignof(V)] = {};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && unit_count_ > 0) {
+      ok = std::fwrite(units_, sizeof(Unit), unit_count_, file) ==
+               unit_count_ &&
+           std::fwrite(zeros, 1, padding, file) == padding;
+    }
+    if (ok && value_count_ > 0) {
+      ok = std::fwrite(values_, sizeof(V), value_count_, file) == value_count_;
+    }
+    if (std::fclose(file) != 0 || !ok) {
+      throw std::runtime_error("cannot write file: " + path);
+    }
+  }
+
+  // 通过 mmap 只读加载 Save 保存的文件，替换当前内容，失败时抛出异常
+  // 加载后直接在映射的内存上查找，不复制数据
+  void Load(const std::string& path) {
+    Reset();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("cannot open file: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+      ::close(fd);
+      throw std::runtime_error("invalid double-array trie file: " + path);
+    }
+    size_t size = st.st_size;
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      throw std::runtime_error("cannot mmap file: " + path);
+    }
+
+    const Header* header = static_cast<const Header*>(addr);
+    const char* base = static_cast<const char*>(addr);
+    bool ok = std::memcmp(header->magic, kMagic_, sizeof(kMagic_)) == 0 &&
+              header->value_size == sizeof(V) &&
+              header->unit_count <= (size - sizeof(Header)) / sizeof(Unit);
+    if (ok) {
+      size_t offset = ValueOffset(header->unit_count);
+      ok = offset <= size &&
+           header->value_count <= (size - offset) / sizeof(V);
+    }
+    if (!ok) {
+      ::munmap(addr, size);
+      throw std::runtime_error("invalid double-array trie file: " + path);
+    }
+    mapping_ = addr;
+    mapping_size_ = size;
+    unit_count_ = header->unit_count;
+    value_count_ = header->value_count;
+    units_ = reinterpret_cast<const Unit*>(base + sizeof(Header));
+    values_ = reinterpret_cast<const V*>(base + ValueOffset(unit_count_));
+  }
+
+  // 查，找到时把值复制到 result 中
+  bool Find(const std::string& key, V& result) const {
+    int64_t index = FindValueIndex(key);
+    if (index < 0) {
+      return false;
+    }
+    result = values_[index];
+    return true;
+  }
+
+  bool Contains(const std::string& key) const {
+    return FindValueIndex(key) >= 0;
+  }
+
+  // 在所有键中寻找 query 的最长前缀
+  std::string FindLongestPrefix(const std::string& query) const {
+    if (unit_count_ == 0) {
+      return "";
+    }
+    size_t max_length = 0;
+    int64_t s = 0;
+    for (size_t i = 0;; i++) {
+      if (Child(s, 0) >= 0) {
+        // query[0..i) 是一个键
+        max_length = i;
+      }
+      if (i == query.size()) {
+        break;
+      }
+      s = Child(s, static_cast<uint8_t>(query[i]) + 1);
+      if (s < 0) {
+        break;
+      }
+    }
+    return query.substr(0, max_length);
+  }
+
+  // 工具函数
+  size_t Size() const { return value_count_; }
+
+  bool Empty() const { return value_count_ == 0; }
+
+  // 双数组占用的字节数（不包括值）
+  size_t ArrayBytes() const { return unit_count_ * sizeof(Unit); }
+
+ private:
+  // 状态 s 经过编码 code 转移后的状态，转移无效时返回 -1
+  // 编码 0 表示键的结尾，字节 c 的编码为 c + 1
+  int64_t Child(int64_t s, int64_t code) const {
+    int64_t t = static_cast<int64_t>(units_[s].base) + code;
+    if (t <= 0 || t >= static_cast<int64_t>(unit_count_) ||
+        units_[t].check != s) {
+      return -1;
+    }
+    return t;
+  }
+
+  // 返回 key 对应的值在 values_ 中的下标，不存在时返回 -1
+  int64_t FindValueIndex(const std::string& key) const {
+    if (unit_count_ == 0) {
+      return -1;
+    }
+    int64_t s = 0;
+    for (char c : key) {
+      s = Child(s, static_cast<uint8_t>(c) + 1);
+      if (s < 0) {
+        return -1;
+      }
+    }
+    int64_t t = Child(s, 0);
+    if (t < 0) {
+      return -1;
+    }
+    // 结尾状态的 base 存储 -(值的下标 + 1)，加载的文件可能已损坏，需检查范围
+    int64_t index = -static_cast<int64_t>(units_[t].base) - 1;
+    if (index < 0 || index >= static_cast<int64_t>(value_count_)) {
+      return -1;
+    }
+    return index;
+  }
+
+  static size_t ValueOffset(size_t unit_count) {
+    size_t offset = sizeof(Header) + unit_count * sizeof(Unit);
+    return (offset + alignof(V) - 1) / alignof(V) * alignof(V);
+  }
+
+  // 释放当前内容（构建的数组或 mmap 映射）
+  void Reset() {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+      mapping_size_ = 0;
+    }
+    owned_units_.clear();
+    owned_units_.shrink_to_fit();
+    owned_values_.clear();
+    owned_values_.shrink_to_fit();
+    units_ = nullptr;
+    values_ = nullptr;
+    unit_count_ = 0;
+    value_count_ = 0;
+  }
+
+  void Build(std::vector<std::pair<std::string, V>>& entries) {
+    if (entries.size() > static_cast<size_t>(INT32_MAX)) {
+      throw std::length_error("too many keys");
+    }
+    Reset();
+    // 按无符号字节的字典序排列，与转移编码的顺序一致
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<std::string, V>& a,
+                 const std::pair<std::string, V>& b) {
+                return a.first < b.first;
+              });
+    owned_values_.reserve(entries.size());
+    for (const auto& entry : entries) {
+      owned_values_.push_back(entry.second);
+    }
+
+    owned_units_.assign(1024, Unit{0, kFree_});
+    owned_units_[0].check = kRoot_;
+    next_free_ = 1;
+    used_ = 1;
+    if (!entries.empty()) {
+      BuildNode(0, entries, 0, entries.size(), 0);
+    }
+    owned_units_.resize(used_);
+    owned_units_.shrink_to_fit();
+
+    units_ = owned_units_.data();
+    unit_count_ = owned_units_.size();
+    values_ = owned_values_.data();
+    value_count_ = owned_values_.size();
+  }
+
+  // 为状态 s 放置子节点，entries[l, r) 是以状态 s 对应的前缀开头的键，前缀长度为 depth
+  void BuildNode(int32_t s,
+                 const std::vector<std::pair<std::string, V>>& entries,
+                 size_t l, size_t r, size_t depth) {
+    // 收集子节点的编码及其对应键区间的起点，键已排序，编码递增
+    std::vector<std::pair<int32_t, size_t>> codes;
+    for (size_t i = l; i < r; i++) {
+      const std::string& key = entries[i].first;
+      int32_t code =
+          depth < key.size() ? static_cast<uint8_t>(key[depth]) + 1 : 0;
+      if (codes.empty() || codes.back().first != code) {
+        codes.emplace_back(code, i);
+      }
+    }
+
+    int32_t base = FindBase(codes);
+    owned_units_[s].base = base;
+    for (const auto& [code, begin] : codes) {
+      owned_units_[base + code].check = s;
+      if (static_cast<size_t>(base + code) + 1 > used_) {
+        used_ = base + code + 1;
+      }
+    }
+    while (owned_units_[next_free_].check != kFree_) {
+      next_free_++;
+    }
+
+    for (size_t k = 0; k < codes.size(); k++) {
+      auto [code, begin] = codes[k];
+      size_t end = k + 1 < codes.size() ? codes[k + 1].second : r;
+      int32_t t = base + code;
+      if (code == 0) {
+        // 键的结尾，只有一个键会在这里结束
+        owned_units_[t].base = -static_cast<int32_t>(begin) - 1;
+      } else {
+        BuildNode(t, entries, begin, end, depth + 1);
+      }
+    }
+  }
+
+  // 从第一个空闲位置开始，寻找能容纳所有子节点编码的 base
+  int32_t FindBase(const std::vector<std::pair<int32_t, size_t>>& codes) {
+    int32_t first = codes.front().first;
+    size_t pos = std::max<size_t>(next_free_, first + 1);
+    while (true) {
+      Reserve(pos + 257);
+      if (owned_units_[pos].check == kFree_) {
+        int32_t base = static_cast<int32_t>(pos) - first;
+        bool fits = true;
+        for (const auto& code : codes) {
+          if (owned_units_[base + code.first].check != kFree_) {
+            fits = false;
+            break;
+          }
+        }
+        if (fits) {
+          return base;
+        }
+      }
+      pos++;
+    }
+  }
+
+  void Reserve(size_t n) {
+    if (n > static_cast<size_t>(INT32_MAX)) {
+      throw std::length_error("double-array trie is too large");
+    }
+    if (owned_units_.size() < n) {
+      owned_units_.resize(std::max(n, owned_units_.size() * 2),
+                          Unit{0, kFree_});
+    }
+  }
+
+  // 查找时只通过以下指针访问数据，它们指向构建的数组或 mmap 映射的内存
+  const Unit* units_{nullptr};
+  size_t unit_count_{0};
+  const V* values_{nullptr};
+  size_t value_count_{0};
+
+  std::vector<Unit> owned_units_;
+  std::vector<V> owned_values_;
+  void* mapping_{nullptr};
+  size_t mapping_size_{0};
+
+  // 构建过程中使用
+  size_t next_free_{1};  // 第一个空闲位置
+  size_t used_{1};       // 已使用的最大位置 + 1
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_DOUBLE_ARRAY_TRIE_H
@@ -0,0 +1,154 @@
+#ifndef XSF_EPOCH_RECLAIMER_H
+#define XSF_EPOCH_RECLAIMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace xsf_data_structures {
+
+// 基于纪元（epoch）的内存回收器，供无锁读的并发容器使用
+// 读线程在访问共享节点前调用 Enter 进入临界区，离开时自动退出
+// 写线程把已摘除的节点交给 Retire，待所有可能持有该节点的读线程都离开后再释放
+// 一个对象被摘除时的全局纪元为 e，当全局纪元推进到 e + 2 时，
+// 所有在摘除前进入临界区的读线程都已经离开，可以安全释放
+class XSFEpochReclaimer {
+ private:
+  // 每个槽位独占一条缓存行，记录占用它的读线程进入临界区时的全局纪元
+  // 0 表示槽位空闲
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> epoch{0};
+  };
+
+  struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    uint64_t epoch;
+  };
+
+ public:
+  // 读临界区，析构时退出
+  class Guard {
+   public:
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() { slot_->epoch.store(0, std::memory_order_release); }
+
+   private:
+    friend class XSFEpochReclaimer;
+
+    explicit Guard(Slot* slot) : slot_(slot) {}
+
+    Slot* slot_;
+  };
+
+  XSFEpochReclaimer() = default;
+
+  XSFEpochReclaimer(const XSFEpochReclaimer&) = delete;
+  XSFEpochReclaimer& operator=(const XSFEpochReclaimer&) = delete;
+
+  // 析构时不能有其他线程在访问
+  ~XSFEpochReclaimer() {
+    for (Retired& retired : retired_) {
+      retired.deleter(retired.ptr);
+    }
+  }
+
+  // 进入读临界区，占用一个空闲槽位
+  // 同时处于临界区的线程数超过槽位个数时自旋等待
+  Guard Enter() {
+    // 每个线程从固定的槽位开始尝试，通常不会与其他线程竞争
+    static thread_local size_t hint =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (size_t i = hint;; i++) {
+      Slot* slot = &slots_[i & (kMaxSlots_ - 1)];
+      uint64_t expected = 0;
+      uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+      if (slot->epoch.load(std::memory_order_relaxed) == 0 &&
+          slot->epoch.compare_exchange_strong(expected, epoch,
+                                              std::memory_order_seq_cst)) {
+        hint = i;
+        return Guard(slot);
+      }
+      if ((i + 1 - hint) % kMaxSlots_ == 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // 摘除的对象交给回收器延迟释放，任意线程都可以调用
+  template <typename T>
+  void Retire(T* ptr) {
+    if (ptr == nullptr) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.push_back({ptr, [](void* p) { delete static_cast<T*>(p); },
+                        epoch_.load(std::memory_order_seq_cst)});
+    if (retired_.size() >= kCollectThreshold_) {
+      Collect();
+    }
+  }
+
+  // 尝试推进全局纪元，并释放已经安全的对象
+  void Reclaim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Collect();
+  }
+
+  // 工具函数，等待释放的对象个数
+  size_t RetiredCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+  }
+
+ private:
+  static const size_t kMaxSlots_{128};  // 必须是 2 的指数
+  static const size_t kCollectThreshold_{64};
+
+  // 调用者需持有 mutex_
+  void Collect() {
+    TryAdvance();
+    uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    size_t j = 0;
+    for (size_t i = 0; i < retired_.size(); i++) {
+      if (retired_[i].epoch + 2 <= epoch) {
+        retired_[i].deleter(retired_[i].ptr);
+      } else {
+        retired_[j++] = retired_[i];
+      }
+    }
+    retired_.resize(j);
+  }
+
+  // 所有处于临界区的读线程都已观察到当前纪元时，纪元才能推进
+  void TryAdvance() {
+    // 保证摘除节点的写操作先于下面对槽位的读取被其他线程看到
+    // 否则在 x86 上写操作可能滞留在存储缓冲区中，读线程进入后仍能看到被摘除的节点
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    for (Slot& slot : slots_) {
+      uint64_t e = slot.epoch.load(std::memory_order_seq_cst);
+      if (e != 0 && e != epoch) {
+        return;
+      }
+    }
+    epoch_.store(epoch + 1, std::memory_order_seq_cst);
+  }
+
+  // 全局纪元从 1 开始，0 保留给空闲槽位
+  alignas(64) std::atomic<uint64_t> epoch_{1};
+  Slot slots_[kMaxSlots_];
+
+  // 等待释放的对象，按摘除时的纪元递增排列
+  std::mutex mutex_;
+  std::vector<Retired> retired_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_EPOCH_RECLAIMER_H
@@ -0,0 +1,343 @@
+#ifndef XSF_INTERVAL_TREE_MAP_H
+#define XSF_INTERVAL_TREE_MAP_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace xsf_data_structures {
+
+// 区间树，以闭区间 [lo, hi] 为键的 map，基于 AVL 树
+// 与 XSFTreeMap 维护 size_ 的方式相同，每个节点额外记录子树中区间右端点的最大值 max_
+// 借助 max_ 剪枝，查询与 [a, b] 重叠的所有区间时只访问可能包含结果的子树
+// 复杂度为 O(min(N, (k + 1) * logN))，k 为结果个数，结果较少时接近 O(logN + k)
+// 严格的 O(logN + k) 需要中心区间树或优先搜索树，但它们无法像这里一样复用 AVL 的旋转
+// 维护增广信息，插入、删除也更复杂，因此没有采用
+// 区间按 (lo, hi) 的字典序排列，相同的区间只保存一份
+template <typename K, typename V, class Compare>
+class XSFIntervalTreeMap {
+ private:
+  struct Node {
+    K lo{};
+    K hi{};
+    V value{};
+    Node* left{nullptr};
+    Node* right{nullptr};
+    // 以该节点为根的子树中所有区间右端点的最大值
+    K max_{};
+    // 记录以该节点为根的子树有多少个节点
+    size_t size_{1};
+    // 记录以该节点为根的子树的高度，叶子节点的高度为 1
+    size_t height_{1};
+
+    Node(const K& l, const K& h, const V& v)
+        : lo(l), hi(h), value(v), max_(h) {}
+
+    Node(const K& l, const K& h, V&& v)
+        : lo(l), hi(h), value(std::move(v)), max_(h) {}
+  };
+
+ public:
+  XSFIntervalTreeMap() = default;
+
+  XSFIntervalTreeMap(const XSFIntervalTreeMap&) = delete;
+  XSFIntervalTreeMap& operator=(const XSFIntervalTreeMap&) = delete;
+
+  ~XSFIntervalTreeMap() { Clear(); }
+
+  // 增、改，区间已存在时替换它的值，hi < lo 时抛出异常（仅提供左值引用版本的区间端点）
+  void Insert(const K& lo, const K& hi, const V& value) {
+    CheckInterval(lo, hi);
+    root_ = Insert(root_, lo, hi, value);
+  }
+
+  void Insert(const K& lo, const K& hi, V&& value) {
+    CheckInterval(lo, hi);
+    root_ = Insert(root_, lo, hi, std::move(value));
+  }
+
+  // 删
+  void Erase(const K& lo, const K& hi) { root_ = Erase(root_, lo, hi); }
+
+  void Clear() {
+    Clear(root_);
+    root_ = nullptr;
+  }
+
+  // 查、改
+  V& Get(const K& lo, const K& hi) {
+    Node* node = FindNode(root_, lo, hi);
+    if (node == nullptr) throw std::out_of_range("interval not found");
+    return node->value;
+  }
+
+  const V& Get(const K& lo, const K& hi) const {
+    Node* node = FindNode(root_, lo, hi);
+    if (node == nullptr) throw std::out_of_range("interval not found");
+    return node->value;
+  }
+
+  bool Contains(const K& lo, const K& hi) const {
+    return FindNode(root_, lo, hi) != nullptr;
+  }
+
+  // 按区间从小到大的顺序，对每个与闭区间 [a, b] 重叠的区间调用
+  // visitor(lo, hi, value)，visitor 返回 false 时提前结束
+  // 结果直接交给 visitor，不会构建中间容器
+  template <typename Visitor>
+  void ForEachOverlap(const K& a, const K& b, Visitor&& visitor) const {
+    ForEachOverlap(root_, a, b, visitor);
+  }
+
+  // 对每个包含 point 的区间调用 visitor(lo, hi, value)
+  template <typename Visitor>
+  void ForEachContaining(const K& point, Visitor&& visitor) const {
+    ForEachOverlap(root_, point, point, visitor);
+  }
+
+  // 是否存在与闭区间 [a, b] 重叠的区间，O(logN)
+  // 只沿一条路径向下查找：左子树的 max_ >= a 时，若左子树中没有重叠的区间，
+  // 则左子树中右端点为 max_ 的区间的左端点大于 b，右子树中的区间更不可能重叠
+  bool AnyOverlap(const K& a, const K& b) const {
+    Node* node = root_;
+    while (node != nullptr) {
+      if (!compare_(b, node->lo) && !compare_(node->hi, a)) {
+        return true;
+      }
+      if (node->left != nullptr && !compare_(node->left->max_, a)) {
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return false;
+  }
+
+  // 工具函数
+  size_t Size() const { return Size(root_); }
+
+  // 返回树的高度，空树的高度为 0
+  size_t Height() const { return Height(root_); }
+
+  bool Empty() const { return root_ == nullptr; }
+
+ private:
+  void CheckInterval(const K& lo, const K& hi) const {
+    if (compare_(hi, lo)) {
+      throw std::invalid_argument("interval end is less than start");
+    }
+  }
+
+  // 按 (lo, hi) 的字典序比较两个区间
+  bool Less(const K& lo1, const K& hi1, const K& lo2, const K& hi2) const {
+    if (compare_(lo1, lo2)) {
+      return true;
+    }
+    if (compare_(lo2, lo1)) {
+      return false;
+    }
+    return compare_(hi1, hi2);
+  }
+
+  // 在以 node 为根的子树中插入区间，返回插入后的根节点
+  template <typename Value>
+  Node* Insert(Node* node, const K& lo, const K& hi, Value&& value) {
+    if (node == nullptr) {
+      return new Node(lo, hi, std::forward<Value>(value));
+    }
+    if (Less(lo, hi, node->lo, node->hi)) {
+      node->left = Insert(node->left, lo, hi, std::forward<Value>(value));
+    } else if (Less(node->lo, node->hi, lo, hi)) {
+      node->right = Insert(node->right, lo, hi, std::forward<Value>(value));
+    } else {
+      // 区间已存在
+      node->value = std::forward<Value>(value);
+      return node;
+    }
+    return Balance(node);
+  }
+
+  // 删除以 node 为根的子树中的最大节点
+  Node* EraseMax(Node* node) {
+    if (node->right == nullptr) {
+      // node 就是最大节点
+      Node* left = node->left;
+      delete node;
+      return left;
+    }
+    node->right = EraseMax(node->right);
+    return Balance(node);
+  }
+
+  // 删除以 node 为根的子树中区间 [lo, hi] 对应的节点
+  Node* Erase(Node* node, const K& lo, const K& hi) {
+    if (node == nullptr) {
+      // 区间对应的节点不存在
+      return nullptr;
+    }
+    if (Less(lo, hi, node->lo, node->hi)) {
+      node->left = Erase(node->left, lo, hi);
+    } else if (Less(node->lo, node->hi, lo, hi)) {
+      node->right = Erase(node->right, lo, hi);
+    } else {
+      // 找到了要删除的节点 node
+      if (node->left == nullptr) {
+        // node 无左子树
+        Node* right = node->right;
+        delete node;
+        return right;
+      }
+      if (node->right == nullptr) {
+        // node 无右子树
+        Node* left = node->left;
+        delete node;
+        return left;
+      }
+      // node 有左右子树，复制左子树的最大节点作为新的根节点
+      Node* left_max{new Node(*FindMax(node->left))};
+      // 删除左子树的最大节点，并用 left_max 替换 node
+      left_max->left = EraseMax(node->left);
+      left_max->right = node->right;
+      delete node;
+      node = left_max;
+    }
+    return Balance(node);
+  }
+
+  // 删除以 node 为根的子树
+  void Clear(Node* node) {
+    if (node == nullptr) {
+      return;
+    }
+    Clear(node->left);
+    Clear(node->right);
+    delete node;
+  }
+
+  // 在以 node 为根的子树中查找最大节点
+  Node* FindMax(Node* node) const {
+    while (node->right != nullptr) {
+      node = node->right;
+    }
+    return node;
+  }
+
+  Node* FindNode(Node* node, const K& lo, const K& hi) const {
+    while (node != nullptr) {
+      if (Less(lo, hi, node->lo, node->hi)) {
+        node = node->left;
+      } else if (Less(node->lo, node->hi, lo, hi)) {
+        node = node->right;
+      } else {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  // 中序遍历以 node 为根的子树中与 [a, b] 重叠的区间
+  // visitor 要求提前结束时返回 false
+  template <typename Visitor>
+  bool ForEachOverlap(Node* node, const K& a, const K& b,
+                      Visitor& visitor) const {
+    if (node == nullptr || compare_(node->max_, a)) {
+      // 子树中所有区间的右端点都小于 a，不可能重叠
+      return true;
+    }
+    if (!ForEachOverlap(node->left, a, b, visitor)) {
+      return false;
+    }
+    if (compare_(b, node->lo)) {
+      // b < node->lo，node 及其右子树中区间的左端点都大于 b
+      return true;
+    }
+    if (!compare_(node->hi, a)) {
+      // node->lo <= b 且 node->hi >= a，两个区间重叠
+      if (!visitor(node->lo, node->hi, static_cast<const V&>(node->value))) {
+        return false;
+      }
+    }
+    return ForEachOverlap(node->right, a, b, visitor);
+  }
+
+  size_t Size(Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    return node->size_;
+  }
+
+  size_t Height(Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    return node->height_;
+  }
+
+  // 根据左右子树重新计算 node 的 max_、size_ 和 height_
+  void Update(Node* node) {
+    node->max_ = node->hi;
+    if (node->left != nullptr && compare_(node->max_, node->left->max_)) {
+      node->max_ = node->left->max_;
+    }
+    if (node->right != nullptr && compare_(node->max_, node->right->max_)) {
+      node->max_ = node->right->max_;
+    }
+    node->size_ = Size(node->left) + 1 + Size(node->right);
+    size_t left_height = Height(node->left);
+    size_t right_height = Height(node->right);
+    node->height_ = (left_height > right_height ? left_height : right_height) + 1;
+  }
+
+  // 左旋，node 的右子节点成为新的根节点，返回旋转后的根节点
+  Node* RotateLeft(Node* node) {
+    Node* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    Update(node);
+    Update(right);
+    return right;
+  }
+
+  // 右旋，node 的左子节点成为新的根节点，返回旋转后的根节点
+  Node* RotateRight(Node* node) {
+    Node* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    Update(node);
+    Update(left);
+    return left;
+  }
+
+  // 在 node 的子树发生变化后调用，更新 max_、size_、height_
+  // 若左右子树高度差超过 1，通过旋转恢复平衡，返回调整后的根节点
+  Node* Balance(Node* node) {
+    Update(node);
+    size_t left_height = Height(node->left);
+    size_t right_height = Height(node->right);
+    if (left_height > right_height + 1) {
+      // 左子树过高
+      if (Height(node->left->left) < Height(node->left->right)) {
+        // LR 型，先将左子树左旋转化为 LL 型
+        node->left = RotateLeft(node->left);
+      }
+      return RotateRight(node);
+    }
+    if (right_height > left_height + 1) {
+      // 右子树过高
+      if (Height(node->right->right) < Height(node->right->left)) {
+        // RL 型，先将右子树右旋转化为 RR 型
+        node->right = RotateRight(node->right);
+      }
+      return RotateLeft(node);
+    }
+    return node;
+  }
+
+  Compare compare_{};
+  Node* root_{nullptr};
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_INTERVAL_TREE_MAP_H
@@ -0,0 +1,202 @@
+#ifndef XSF_LOCK_FREE_STACK_H
+#define XSF_LOCK_FREE_STACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace xsf_data_structures {
+
+// 侵入式无锁节点栈，Node 需要提供 std::atomic<Node*> next 字段
+// 链表头带有版本号，低 48 位存储指针，高 16 位存储版本号
+// 用户态地址在 x86-64、AArch64 上都不超过 48 位
+// 节点必须在栈的生命周期内保持有效（不被释放），调用者负责回收
+template <typename Node>
+class XSFTaggedNodeStack {
+  static_assert(sizeof(void*) == 8, "tagged pointer requires 64-bit pointers");
+
+ public:
+  void PushNode(Node* node) {
+    uint64_t old_head = head_.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do {
+      node->next.store(Ptr(old_head), std::memory_order_relaxed);
+      new_head = Pack(node, Tag(old_head) + 1);
+    } while (!head_.compare_exchange_weak(old_head, new_head,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+  void PushChain(Node* first, Node* last) {
+    uint64_t old_head = head_.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do {
+      last->next.store(Ptr(old_head), std::memory_order_relaxed);
+      new_head = Pack(first, Tag(old_head) + 1);
+    } while (!head_.compare_exchange_weak(old_head, new_head,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+  Node* PopNode() {
+    uint64_t old_head = head_.load(std::memory_order_acquire);
+    while (Ptr(old_head) != nullptr) {
+      // 节点不会被释放，即使已被其他线程弹出，读取 next 也是安全的
+      // 若节点已被弹出，版本号一定已经变化，下面的 CAS 会失败
+      Node* next = Ptr(old_head)->next.load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(old_head,
+                                      Pack(next, Tag(old_head) + 1),
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+        return Ptr(old_head);
+      }
+    }
+    return nullptr;
+  }
+
+  // 一次交换取走整条链表
+  Node* TakeAll() {
+    uint64_t old_head = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(old_head,
+                                        Pack(nullptr, Tag(old_head) + 1),
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+    }
+    return Ptr(old_head);
+  }
+
+  bool Empty() const {
+    return Ptr(head_.load(std::memory_order_acquire)) == nullptr;
+  }
+
+ private:
+  static constexpr uint64_t kPtrMask_{(uint64_t(1) << 48) - 1};
+
+  static uint64_t Pack(Node* node, uint64_t tag) {
+    return reinterpret_cast<uint64_t>(node) | (tag << 48);
+  }
+
+  static Node* Ptr(uint64_t head) {
+    return reinterpret_cast<Node*>(head & kPtrMask_);
+  }
+
+  static uint64_t Tag(uint64_t head) { return head >> 48; }
+
+  std::atomic<uint64_t> head_{0};
+};
+
+// 无锁栈（Treiber 栈），可以被多个线程同时 Push、TryPop、PopAll
+// 栈顶指针带有版本号（tag），每次修改都会递增，以此避免 ABA 问题
+// 弹出的节点不会归还给系统，而是放入内部的空闲链表中复用
+// 因此并发读取一个刚被弹出的节点的 next 字段总是安全的
+template <typename T>
+class XSFLockFreeStack {
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    // 未构造的 T，节点在空闲链表中时不持有对象
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* Value() { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+ public:
+  XSFLockFreeStack() = default;
+
+  XSFLockFreeStack(const XSFLockFreeStack&) = delete;
+  XSFLockFreeStack& operator=(const XSFLockFreeStack&) = delete;
+
+  // 析构时不能有其他线程在访问
+  ~XSFLockFreeStack() {
+    for (Node* node = stack_.TakeAll(); node != nullptr;) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      node->Value()->~T();
+      delete node;
+      node = next;
+    }
+    for (Node* node = free_.TakeAll(); node != nullptr;) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+  }
+
+  // 增
+  void Push(const T& value) { stack_.PushNode(MakeNode(value)); }
+
+  void Push(T&& value) { stack_.PushNode(MakeNode(std::move(value))); }
+
+  template <typename... Args>
+  void Emplace(Args&&... args) {
+    stack_.PushNode(MakeNode(std::forward<Args>(args)...));
+  }
+
+  // 删
+  // 弹出栈顶元素到 out 中，栈为空时返回 false
+  bool TryPop(T& out) {
+    Node* node = stack_.PopNode();
+    if (node == nullptr) {
+      return false;
+    }
+    out = std::move(*node->Value());
+    node->Value()->~T();
+    free_.PushNode(node);
+    return true;
+  }
+
+  // 一次交换取走栈中的所有元素，按出栈顺序（后进先出）依次调用 visitor
+  // 返回取走的元素个数
+  template <typename Visitor>
+  size_t PopAll(Visitor&& visitor) {
+    Node* first = stack_.TakeAll();
+    if (first == nullptr) {
+      return 0;
+    }
+    size_t count = 0;
+    Node* last = first;
+    for (Node* node = first; node != nullptr;
+         node = node->next.load(std::memory_order_relaxed)) {
+      visitor(std::move(*node->Value()));
+      node->Value()->~T();
+      last = node;
+      count++;
+    }
+    // 整条链表一次性归还给空闲链表
+    free_.PushChain(first, last);
+    return count;
+  }
+
+  // 工具函数，并发情况下只是一个瞬时值
+  bool Empty() const { return stack_.Empty(); }
+
+ private:
+  // 优先复用空闲链表中的节点
+  Node* AllocNode() {
+    Node* node = free_.PopNode();
+    if (node == nullptr) {
+      node = new Node();
+    }
+    return node;
+  }
+
+  // 取一个节点并在其中构造 T，构造抛出异常时把节点归还到空闲链表
+  template <typename... Args>
+  Node* MakeNode(Args&&... args) {
+    Node* node = AllocNode();
+    try {
+      new (node->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      free_.PushNode(node);
+      throw;
+    }
+    return node;
+  }
+
+  alignas(64) XSFTaggedNodeStack<Node> stack_;
+  alignas(64) XSFTaggedNodeStack<Node> free_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_LOCK_FREE_STACK_H
@@ -0,0 +1,151 @@
+#ifndef XSF_MPSC_QUEUE_H
+#define XSF_MPSC_QUEUE_H
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "xsf_lock_free_stack.h"
+
+namespace xsf_data_structures {
+
+// 无界无锁多生产者单消费者队列（Vyukov MPSC），基于单向链表
+// 任意线程都可以调用 Push，链接到队尾只需一次原子交换，不会重试
+// 但从空闲链表取节点是 CAS 重试循环，因此 Push 整体只是无锁（lock-free）的，不是无等待的
+// 只有一个消费者线程可以调用 Pop、Front、Empty
+// 出队的节点通过空闲链表回收，供生产者复用，稳定状态下不再分配内存
+template <typename T>
+class XSFMPSCQueue {
+ private:
+  struct Node {
+    // 节点在队列中时指向后继节点，在空闲链表中时指向下一个空闲节点
+    std::atomic<Node*> next{nullptr};
+    // 未构造的 T，哨兵节点和空闲节点不持有对象
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* Value() { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+ public:
+  XSFMPSCQueue() {
+    Node* dummy = new Node();
+    head_.store(dummy, std::memory_order_relaxed);
+    tail_ = dummy;
+  }
+
+  XSFMPSCQueue(const XSFMPSCQueue&) = delete;
+  XSFMPSCQueue& operator=(const XSFMPSCQueue&) = delete;
+
+  // 析构时不能有其他线程在访问
+  ~XSFMPSCQueue() {
+    while (Pop()) {
+    }
+    delete tail_;
+    for (Node* node = free_.TakeAll(); node != nullptr;) {
+      Node* next = node->next.load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+  }
+
+  // 增，任意线程
+  void Push(const T& value) { Link(MakeNode(value)); }
+
+  void Push(T&& value) { Link(MakeNode(std::move(value))); }
+
+  template <typename... Args>
+  void Emplace(Args&&... args) {
+    Link(MakeNode(std::forward<Args>(args)...));
+  }
+
+  // 删，仅限消费者线程
+  // 弹出队头元素，队列为空时返回 false
+  bool Pop() {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    next->Value()->~T();
+    Advance(next);
+    return true;
+  }
+
+  // 弹出队头元素到 out 中，队列为空时返回 false
+  bool Pop(T& out) {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    out = std::move(*next->Value());
+    next->Value()->~T();
+    Advance(next);
+    return true;
+  }
+
+  // 查、改，仅限消费者线程
+  T& Front() {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) throw std::out_of_range("queue is empty");
+    return *next->Value();
+  }
+
+  const T& Front() const {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) throw std::out_of_range("queue is empty");
+    return *next->Value();
+  }
+
+  // 工具函数，仅限消费者线程
+  // 生产者已交换 head_ 但尚未链接 next 时，元素暂时不可见
+  bool Empty() const {
+    return tail_->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  // 优先复用空闲链表中的节点
+  Node* AllocNode() {
+    Node* node = free_.PopNode();
+    if (node == nullptr) {
+      node = new Node();
+    }
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+  }
+
+  // 取一个节点并在其中构造 T，构造抛出异常时把节点归还到空闲链表
+  template <typename... Args>
+  Node* MakeNode(Args&&... args) {
+    Node* node = AllocNode();
+    try {
+      new (node->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      free_.PushNode(node);
+      throw;
+    }
+    return node;
+  }
+
+  // 将 node 链接到队尾
+  void Link(Node* node) {
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // 原哨兵节点出队回收，next 成为新的哨兵节点
+  void Advance(Node* next) {
+    Node* dummy = tail_;
+    tail_ = next;
+    free_.PushNode(dummy);
+  }
+
+  // head_ 指向最后入队的节点，由生产者竞争修改
+  alignas(64) std::atomic<Node*> head_{nullptr};
+  // tail_ 指向哨兵节点，其后继才是队头元素，仅由消费者访问
+  alignas(64) Node* tail_{nullptr};
+  alignas(64) XSFTaggedNodeStack<Node> free_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_MPSC_QUEUE_H
@@ -0,0 +1,768 @@
+#ifndef XSF_RADIX_TRIE_MAP_H
+#define XSF_RADIX_TRIE_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "xsf_trie_alphabet.h"
+
+namespace xsf_data_structures {
+
+// 基数树（压缩前缀树）实现的 map，接口与 XSFTrieMap 一致
+// 与 XSFTrieMap 相比有两点不同：
+// 1. 路径压缩：只有一个子节点且不存储值的节点链被合并，合并掉的字符存储在节点的 prefix 中
+// 2. 自适应节点（参考 ART）：按子节点个数选用 Node4、Node16、Node48、Node256
+//    只有分叉很多的节点才需要 256 个指针，大部分节点只占几十字节
+// 键按字节（unsigned char）处理，可以包含任意字符
+// Encoding 为编码策略（见 xsf_trie_alphabet.h），决定通配符 . 匹配的一个字符占几个字节
+// 使用 XSFUtf8Encoding 时只接受合法的 UTF-8 键，通配符匹配一个完整的码点
+// 码点的各个字节与其他字节一样存储在压缩的 prefix 中，不会额外增加节点
+template <typename V, class Encoding = XSFByteEncoding>
+class XSFRadixTrieMap {
+ private:
+  enum NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+  // 到达一个节点的路径 = 父节点的路径 + 分支字符 + 节点的 prefix
+  struct Node {
+    NodeType type;
+    uint16_t count{0};  // 子节点个数
+    V* value{nullptr};
+    std::string prefix;
+
+    explicit Node(NodeType t) : type(t) {}
+  };
+
+  // 子节点按字符从小到大排列
+  struct Node4 : Node {
+    uint8_t keys[4];
+    Node* children[4];
+
+    Node4() : Node(NODE4) {}
+  };
+
+  struct Node16 : Node {
+    uint8_t keys[16];
+    Node* children[16];
+
+    Node16() : Node(NODE16) {}
+  };
+
+  // index[c] 为 0 表示字符 c 没有子节点，否则子节点是 children[index[c] - 1]
+  struct Node48 : Node {
+    uint8_t index[256];
+    Node* children[48];
+
+    Node48() : Node(NODE48) {
+      for (size_t i = 0; i < 256; i++) {
+        index[i] = 0;
+      }
+      for (size_t i = 0; i < 48; i++) {
+        children[i] = nullptr;
+      }
+    }
+  };
+
+  struct Node256 : Node {
+    Node* children[256];
+
+    Node256() : Node(NODE256) {
+      for (size_t i = 0; i < 256; i++) {
+        children[i] = nullptr;
+      }
+    }
+  };
+
+ public:
+  XSFRadixTrieMap() = default;
+
+  XSFRadixTrieMap(const XSFRadixTrieMap&) = delete;
+  XSFRadixTrieMap& operator=(const XSFRadixTrieMap&) = delete;
+
+  ~XSFRadixTrieMap() { Clear(); }
+
+  // 增、改
+  // 键不是合法的编码时抛出异常
+  V& operator[](const std::string& key) {
+    if (!Encoding::Valid(key)) {
+      throw std::invalid_argument("key is not validly encoded");
+    }
+    return Insert(root_, key, 0);
+  }
+
+  // 删
+  void Erase(const std::string& key) { Erase(root_, key, 0); }
+
+  void Clear() {
+    Clear(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  // 查
+  bool Contains(const std::string& key) const {
+    Node* node = root_;
+    size_t depth = 0;
+    while (node != nullptr) {
+      if (!MatchPrefix(node, key, depth)) {
+        return false;
+      }
+      depth += node->prefix.size();
+      if (depth == key.size()) {
+        return node->value != nullptr;
+      }
+      Node* const* child = FindChild(node, key[depth]);
+      node = child == nullptr ? nullptr : *child;
+      depth++;
+    }
+    return false;
+  }
+
+  // 在所有键中寻找 query 的最短前缀
+  std::string FindShortestPrefix(const std::string& query) const {
+    Node* node = root_;
+    size_t depth = 0;
+    while (node != nullptr && MatchPrefix(node, query, depth)) {
+      depth += node->prefix.size();
+      if (node->value != nullptr) {
+        // 第一个存储了 value 的节点就是最短前缀
+        return query.substr(0, depth);
+      }
+      if (depth == query.size()) {
+        break;
+      }
+      Node* const* child = FindChild(node, query[depth]);
+      node = child == nullptr ? nullptr : *child;
+      depth++;
+    }
+    return "";
+  }
+
+  // 在所有键中寻找 query 的最长前缀
+  std::string FindLongestPrefix(const std::string& query) const {
+    // 记录前缀的最大长度
+    size_t max_length = 0;
+    Node* node = root_;
+    size_t depth = 0;
+    while (node != nullptr && MatchPrefix(node, query, depth)) {
+      depth += node->prefix.size();
+      if (node->value != nullptr) {
+        // 找到一个键是 query 的前缀，更新前缀的最大长度
+        max_length = depth;
+      }
+      if (depth == query.size()) {
+        break;
+      }
+      Node* const* child = FindChild(node, query[depth]);
+      node = child == nullptr ? nullptr : *child;
+      depth++;
+    }
+    return query.substr(0, max_length);
+  }
+
+  // 搜索前缀为 prefix 的所有键
+  std::list<std::string> FindKeysWithPrefix(const std::string& prefix) const {
+    std::list<std::string> keys;
+    std::string path;
+    Node* node = FindPrefixNode(prefix, path);
+    if (node != nullptr) {
+      Traverse(node, path, keys);
+    }
+    return keys;
+  }
+
+  // 判断是否存在前缀为 prefix 的键
+  bool ContainsKeysWithPrefix(const std::string& prefix) const {
+    std::string path;
+    return FindPrefixNode(prefix, path) != nullptr;
+  }
+
+  // 搜索符合 pattern 的所有键（通配符 . 匹配任意一个字符）
+  std::list<std::string> FindKeysWithPattern(const std::string& pattern) const {
+    std::list<std::string> keys;
+    std::string path;
+    Match(root_, pattern, 0, 0, path, &keys);
+    return keys;
+  }
+
+  // 判断是否存在符合 pattern 的键（通配符 . 匹配任意一个字符）
+  bool ContainsKeysWithPattern(const std::string& pattern) const {
+    std::string path;
+    return Match(root_, pattern, 0, 0, path, nullptr);
+  }
+
+  // 工具函数
+  size_t Size() const { return size_; }
+
+  bool Empty() const { return size_ == 0; }
+
+  // 估算占用的内存字节数，包括节点、prefix 的堆内存和 value
+  size_t MemoryUsage() const { return sizeof(*this) + MemoryUsage(root_); }
+
+ private:
+  // 从 key[depth..] 开始是否完整匹配 node 的 prefix
+  bool MatchPrefix(Node* node, const std::string& key, size_t depth) const {
+    return key.size() - depth >= node->prefix.size() &&
+           key.compare(depth, node->prefix.size(), node->prefix) == 0;
+  }
+
+  // 返回 node 的 prefix 与 key[depth..] 的公共前缀长度
+  size_t CommonPrefix(Node* node, const std::string& key, size_t depth) const {
+    size_t n = node->prefix.size();
+    if (key.size() - depth < n) {
+      n = key.size() - depth;
+    }
+    size_t i = 0;
+    while (i < n && node->prefix[i] == key[depth + i]) {
+      i++;
+    }
+    return i;
+  }
+
+  // 新建一个存储 key[depth..] 的叶子节点
+  Node* NewLeaf(const std::string& key, size_t depth) {
+    Node* leaf = new Node4();
+    leaf->prefix = key.substr(depth);
+    leaf->value = new V{};
+    size_++;
+    return leaf;
+  }
+
+  // 向 ref 指向的子树中插入 key[depth..]，返回 value 的引用
+  V& Insert(Node*& ref, const std::string& key, size_t depth) {
+    if (ref == nullptr) {
+      ref = NewLeaf(key, depth);
+      return *ref->value;
+    }
+    Node* node = ref;
+    size_t p = CommonPrefix(node, key, depth);
+    if (p < node->prefix.size()) {
+      // key 与 prefix 在中途分叉，拆分出一个新的父节点，存储公共部分
+      Node* parent = new Node4();
+      parent->prefix = node->prefix.substr(0, p);
+      uint8_t c = node->prefix[p];
+      node->prefix.erase(0, p + 1);
+      AddChild(parent, c, node);
+      ref = parent;
+      depth += p;
+      if (depth == key.size()) {
+        parent->value = new V{};
+        size_++;
+        return *parent->value;
+      }
+      Node* leaf = NewLeaf(key, depth + 1);
+      AddChild(ref, key[depth], leaf);
+      return *leaf->value;
+    }
+
+    depth += p;
+    if (depth == key.size()) {
+      if (node->value == nullptr) {
+        node->value = new V{};
+        size_++;
+      }
+      return *node->value;
+    }
+    Node** child = FindChild(node, key[depth]);
+    if (child != nullptr) {
+      return Insert(*child, key, depth + 1);
+    }
+    Node* leaf = NewLeaf(key, depth + 1);
+    AddChild(ref, key[depth], leaf);
+    return *leaf->value;
+  }
+
+  // 在 ref 指向的子树中删除 key[depth..]，返回是否删除成功
+  bool Erase(Node*& ref, const std::string& key, size_t depth) {
+    Node* node = ref;
+    if (node == nullptr || !MatchPrefix(node, key, depth)) {
+      return false;
+    }
+    depth += node->prefix.size();
+    if (depth == key.size()) {
+      if (node->value == nullptr) {
+        return false;
+      }
+      delete node->value;
+      node->value = nullptr;
+      size_--;
+    } else {
+      uint8_t c = key[depth];
+      Node** child = FindChild(node, c);
+      if (child == nullptr || !Erase(*child, key, depth + 1)) {
+        return false;
+      }
+      if (*child == nullptr) {
+        RemoveChild(ref, c);
+        node = ref;
+      }
+    }
+
+    // 后序位置，node 可能需要被清理或与唯一的子节点合并
+    if (node->value != nullptr) {
+      return true;
+    }
+    if (node->count == 0) {
+      DeleteNode(node);
+      ref = nullptr;
+    } else if (node->count == 1) {
+      // 路径压缩：把 node 的 prefix 和分支字符并入唯一的子节点
+      uint8_t c = 0;
+      Node* only = nullptr;
+      ForEachChild(node, [&c, &only](uint8_t b, Node* child) {
+        c = b;
+        only = child;
+        return false;
+      });
+      only->prefix = node->prefix + static_cast<char>(c) + only->prefix;
+      DeleteNode(node);
+      ref = only;
+    }
+    return true;
+  }
+
+  // 删除以 node 为根的子树
+  void Clear(Node* node) {
+    if (node == nullptr) {
+      return;
+    }
+    ForEachChild(node, [this](uint8_t, Node* child) {
+      Clear(child);
+      return true;
+    });
+    delete node->value;
+    DeleteNode(node);
+  }
+
+  // 按节点的实际类型释放节点本身（不包括 value 和子节点）
+  void DeleteNode(Node* node) {
+    switch (node->type) {
+      case NODE4:
+        delete static_cast<Node4*>(node);
+        break;
+      case NODE16:
+        delete static_cast<Node16*>(node);
+        break;
+      case NODE48:
+        delete static_cast<Node48*>(node);
+        break;
+      case NODE256:
+        delete static_cast<Node256*>(node);
+        break;
+    }
+  }
+
+  // 返回 node 中字符 c 对应的子节点指针的地址，不存在时返回 null
+  Node** FindChild(Node* node, uint8_t c) const {
+    switch (node->type) {
+      case NODE4: {
+        Node4* n = static_cast<Node4*>(node);
+        for (size_t i = 0; i < n->count; i++) {
+          if (n->keys[i] == c) {
+            return &n->children[i];
+          }
+        }
+        return nullptr;
+      }
+      case NODE16: {
+        Node16* n = static_cast<Node16*>(node);
+        for (size_t i = 0; i < n->count && n->keys[i] <= c; i++) {
+          if (n->keys[i] == c) {
+            return &n->children[i];
+          }
+        }
+        return nullptr;
+      }
+      case NODE48: {
+        Node48* n = static_cast<Node48*>(node);
+        return n->index[c] == 0 ? nullptr : &n->children[n->index[c] - 1];
+      }
+      case NODE256: {
+        Node256* n = static_cast<Node256*>(node);
+        return n->children[c] == nullptr ? nullptr : &n->children[c];
+      }
+    }
+    return nullptr;
+  }
+
+  // 按字符从小到大对 node 的每个子节点调用 f(c, child)，f 返回 false 时提前结束
+  // 返回是否遍历完所有子节点
+  template <typename F>
+  bool ForEachChild(Node* node, F&& f) const {
+    switch (node->type) {
+      case NODE4: {
+        Node4* n = static_cast<Node4*>(node);
+        for (size_t i = 0; i < n->count; i++) {
+          if (!f(n->keys[i], n->children[i])) {
+            return false;
+          }
+        }
+        break;
+      }
+      case NODE16: {
+        Node16* n = static_cast<Node16*>(node);
+        for (size_t i = 0; i < n->count; i++) {
+          if (!f(n->keys[i], n->children[i])) {
+            return false;
+          }
+        }
+        break;
+      }
+      case NODE48: {
+        Node48* n = static_cast<Node48*>(node);
+        for (size_t c = 0; c < 256; c++) {
+          if (n->index[c] != 0 &&
+              !f(static_cast<uint8_t>(c), n->children[n->index[c] - 1])) {
+            return false;
+          }
+        }
+        break;
+      }
+      case NODE256: {
+        Node256* n = static_cast<Node256*>(node);
+        for (size_t c = 0; c < 256; c++) {
+          if (n->children[c] != nullptr &&
+              !f(static_cast<uint8_t>(c), n->children[c])) {
+            return false;
+          }
+        }
+        break;
+      }
+    }
+    return true;
+  }
+
+  // 把 from 的公共字段转移到 to 中
+  void MoveHeader(Node* from, Node* to) {
+    to->count = from->count;
+    to->value = from->value;
+    to->prefix = std::move(from->prefix);
+  }
+
+  // 在有序数组 keys[0..count) 中插入字符 c 及其子节点
+  static void InsertSorted(uint8_t* keys, Node** children, size_t count,
+                           uint8_t c, Node* child) {
+    size_t i = count;
+    while (i > 0 && keys[i - 1] > c) {
+      keys[i] = keys[i - 1];
+      children[i] = children[i - 1];
+      i--;
+    }
+    keys[i] = c;
+    children[i] = child;
+  }
+
+  // 从有序数组 keys[0..count) 中删除字符 c 及其子节点
+  static void EraseSorted(uint8_t* keys, Node** children, size_t count,
+                          uint8_t c) {
+    size_t i = 0;
+    while (keys[i] != c) {
+      i++;
+    }
+    for (; i + 1 < count; i++) {
+      keys[i] = keys[i + 1];
+      children[i] = children[i + 1];
+    }
+  }
+
+  // 为 ref 指向的节点添加字符 c 对应的子节点（c 原先不存在）
+  // 节点已满时先换成更大的节点类型，ref 随之更新
+  void AddChild(Node*& ref, uint8_t c, Node* child) {
+    Node* node = ref;
+    switch (node->type) {
+      case NODE4: {
+        Node4* n = static_cast<Node4*>(node);
+        if (n->count < 4) {
+          InsertSorted(n->keys, n->children, n->count, c, child);
+          break;
+        }
+        Node16* bigger = new Node16();
+        MoveHeader(n, bigger);
+        for (size_t i = 0; i < 4; i++) {
+          bigger->keys[i] = n->keys[i];
+          bigger->children[i] = n->children[i];
+        }
+        delete n;
+        ref = bigger;
+        InsertSorted(bigger->keys, bigger->children, bigger->count, c, child);
+        break;
+      }
+      case NODE16: {
+        Node16* n = static_cast<Node16*>(node);
+        if (n->count < 16) {
+          InsertSorted(n->keys, n->children, n->count, c, child);
+          break;
+        }
+        Node48* bigger = new Node48();
+        MoveHeader(n, bigger);
+        for (size_t i = 0; i < 16; i++) {
+          bigger->index[n->keys[i]] = static_cast<uint8_t>(i + 1);
+          bigger->children[i] = n->children[i];
+        }
+        delete n;
+        ref = bigger;
+        bigger->index[c] = 17;
+        bigger->children[16] = child;
+        break;
+      }
+      case NODE48: {
+        Node48* n = static_cast<Node48*>(node);
+        if (n->count < 48) {
+          size_t slot = 0;
+          while (n->children[slot] != nullptr) {
+            slot++;
+          }
+          n->index[c] = static_cast<uint8_t>(slot + 1);
+          n->children[slot] = child;
+          break;
+        }
+        Node256* bigger = new Node256();
+        MoveHeader(n, bigger);
+        for (size_t i = 0; i < 256; i++) {
+          if (n->index[i] != 0) {
+            bigger->children[i] = n->children[n->index[i] - 1];
+          }
+        }
+        delete n;
+        ref = bigger;
+        bigger->children[c] = child;
+        break;
+      }
+      case NODE256:
+        static_cast<Node256*>(node)->children[c] = child;
+        break;
+    }
+    ref->count++;
+  }
+
+  // 删除 ref 指向的节点中字符 c 对应的子节点（c 一定存在，子节点已释放）
+  // 子节点个数低于阈值时换成更小的节点类型，阈值低于扩容点以避免反复转换
+  void RemoveChild(Node*& ref, uint8_t c) {
+    Node* node = ref;
+    node->count--;
+    switch (node->type) {
+      case NODE4: {
+        Node4* n = static_cast<Node4*>(node);
+        EraseSorted(n->keys, n->children, n->count + 1, c);
+        break;
+      }
+      case NODE16: {
+        Node16* n = static_cast<Node16*>(node);
+        EraseSorted(n->keys, n->children, n->count + 1, c);
+        if (n->count > 3) {
+          break;
+        }
+        Node4* smaller = new Node4();
+        MoveHeader(n, smaller);
+        for (size_t i = 0; i < n->count; i++) {
+          smaller->keys[i] = n->keys[i];
+          smaller->children[i] = n->children[i];
+        }
+        delete n;
+        ref = smaller;
+        break;
+      }
+      case NODE48: {
+        Node48* n = static_cast<Node48*>(node);
+        n->children[n->index[c] - 1] = nullptr;
+        n->index[c] = 0;
+        if (n->count > 12) {
+          break;
+        }
+        Node16* smaller = new Node16();
+        MoveHeader(n, smaller);
+        size_t j = 0;
+        for (size_t i = 0; i < 256; i++) {
+          if (n->index[i] != 0) {
+            smaller->keys[j] = static_cast<uint8_t>(i);
+            smaller->children[j] = n->children[n->index[i] - 1];
+            j++;
+          }
+        }
+        delete n;
+        ref = smaller;
+        break;
+      }
+      case NODE256: {
+        Node256* n = static_cast<Node256*>(node);
+        n->children[c] = nullptr;
+        if (n->count > 37) {
+          break;
+        }
+        Node48* smaller = new Node48();
+        MoveHeader(n, smaller);
+        size_t j = 0;
+        for (size_t i = 0; i < 256; i++) {
+          if (n->children[i] != nullptr) {
+            smaller->index[i] = static_cast<uint8_t>(j + 1);
+            smaller->children[j] = n->children[i];
+            j++;
+          }
+        }
+        delete n;
+        ref = smaller;
+        break;
+      }
+    }
+  }
+
+  // 找到所有键都以 prefix 开头的最高节点，path 为到达该节点（含其 prefix）的完整路径
+  // 不存在前缀为 prefix 的键时返回 null
+  Node* FindPrefixNode(const std::string& prefix, std::string& path) const {
+    Node* node = root_;
+    size_t depth = 0;
+    while (node != nullptr) {
+      size_t p = CommonPrefix(node, prefix, depth);
+      if (depth + p == prefix.size()) {
+        // prefix 在 node 的 prefix 中（或恰好在末尾）结束
+        path = prefix.substr(0, depth) + node->prefix;
+        return node;
+      }
+      if (p < node->prefix.size()) {
+        return nullptr;
+      }
+      depth += p;
+      Node* const* child = FindChild(node, prefix[depth]);
+      node = child == nullptr ? nullptr : *child;
+      depth++;
+    }
+    return nullptr;
+  }
+
+  // 遍历以 node 为根的子树，找到所有键，path 已包含 node 的 prefix
+  void Traverse(Node* node, std::string& path,
+                std::list<std::string>& keys) const {
+    if (node->value != nullptr) {
+      // 找到一个 key，添加到结果列表中
+      keys.push_back(path);
+    }
+    size_t length = path.size();
+    ForEachChild(node, [&](uint8_t c, Node* child) {
+      // 做选择
+      path.push_back(static_cast<char>(c));
+      path += child->prefix;
+      Traverse(child, path, keys);
+      // 撤销选择
+      path.resize(length);
+      return true;
+    });
+  }
+
+  // 尝试在以 node 为根的子树中匹配 pattern[i..]（通配符 . 匹配任意一个字符）
+  // pending 为上一个通配符匹配的字符还剩几个后续字节，一个字符可能跨越多个节点
+  // keys 不为 null 时收集所有匹配的键，否则找到一个匹配即返回 true
+  bool Match(Node* node, const std::string& pattern, size_t i, size_t pending,
+             std::string& path, std::list<std::string>* keys) const {
+    if (node == nullptr) {
+      return false;
+    }
+    // 压缩的 prefix 也要逐个字节与 pattern 匹配
+    for (char b : node->prefix) {
+      if (!MatchByte(pattern, i, pending, static_cast<uint8_t>(b))) {
+        return false;
+      }
+    }
+    size_t length = path.size();
+    path += node->prefix;
+    bool found = false;
+    if (pending == 0 && i == pattern.size()) {
+      if (node->value != nullptr) {
+        found = true;
+        if (keys != nullptr) {
+          keys->push_back(path);
+        }
+      }
+    } else if (pending == 0 && pattern[i] != '.') {
+      Node* const* child = FindChild(node, pattern[i]);
+      if (child != nullptr) {
+        path.push_back(pattern[i]);
+        found = Match(*child, pattern, i + 1, 0, path, keys);
+        path.pop_back();
+      }
+    } else {
+      // 通配符，尝试所有子节点
+      ForEachChild(node, [&](uint8_t c, Node* child) {
+        size_t next = i;
+        size_t rest = pending;
+        if (MatchByte(pattern, next, rest, c)) {
+          path.push_back(static_cast<char>(c));
+          if (Match(child, pattern, next, rest, path, keys)) {
+            found = true;
+          }
+          path.pop_back();
+        }
+        return keys != nullptr || !found;
+      });
+    }
+    path.resize(length);
+    return found;
+  }
+
+  // 用键的字节 b 匹配 pattern[i..]，成功时更新 i 和 pending
+  bool MatchByte(const std::string& pattern, size_t& i, size_t& pending,
+                 uint8_t b) const {
+    if (pending > 0) {
+      // b 是通配符所匹配字符的后续字节
+      pending--;
+      return true;
+    }
+    if (i == pattern.size()) {
+      return false;
+    }
+    if (pattern[i] == '.') {
+      size_t n = Encoding::SymbolLength(b);
+      if (n == 0) {
+        return false;
+      }
+      pending = n - 1;
+      i++;
+      return true;
+    }
+    return static_cast<uint8_t>(pattern[i++]) == b;
+  }
+
+  size_t MemoryUsage(Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    size_t bytes = 0;
+    switch (node->type) {
+      case NODE4:
+        bytes = sizeof(Node4);
+        break;
+      case NODE16:
+        bytes = sizeof(Node16);
+        break;
+      case NODE48:
+        bytes = sizeof(Node48);
+        break;
+      case NODE256:
+        bytes = sizeof(Node256);
+        break;
+    }
+    // 短字符串存储在 std::string 对象内部，不占用额外的堆内存
+    const char* data = node->prefix.data();
+    const char* self = reinterpret_cast<const char*>(&node->prefix);
+    if (data < self || data >= self + sizeof(node->prefix)) {
+      bytes += node->prefix.capacity() + 1;
+    }
+    if (node->value != nullptr) {
+      bytes += sizeof(V);
+    }
+    ForEachChild(node, [this, &bytes](uint8_t, Node* child) {
+      bytes += MemoryUsage(child);
+      return true;
+    });
+    return bytes;
+  }
+
+  size_t size_{0};
+  Node* root_{nullptr};
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_RADIX_TRIE_MAP_H
@@ -0,0 +1,241 @@
+#ifndef XSF_SEGMENTED_STACK_H
+#define XSF_SEGMENTED_STACK_H
+
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace xsf_data_structures {
+
+// 栈，基于按几何级数增长的分段数组
+// 扩容时只追加新的分段，已有元素永远不会被搬移
+template <typename T>
+class XSFSegmentedStack {
+ public:
+  // 出栈导致分段变空时的保留策略
+  enum RetainPolicy {
+    RETAIN_ALL,  // 保留所有已分配的分段，只在 ShrinkToFit 或析构时释放
+    RETAIN_ONE,  // 只保留一个空闲分段，避免在分段边界上反复分配、释放
+    RELEASE,     // 分段变空后立即释放
+  };
+
+  XSFSegmentedStack(size_t capacity = 2, RetainPolicy policy = RETAIN_ONE)
+      : base_capacity_(capacity == 0 ? 1 : capacity), policy_(policy) {
+    AllocSegment(0);
+  }
+
+  XSFSegmentedStack(const XSFSegmentedStack&) = delete;
+  XSFSegmentedStack& operator=(const XSFSegmentedStack&) = delete;
+
+  ~XSFSegmentedStack() {
+    Clear();
+    ReleaseSegments(0);
+  }
+
+  // 增
+  void Push(const T& data) {
+    new (NextSlot()) T(data);
+    CommitSlot();
+  }
+
+  void Push(T&& data) {
+    new (NextSlot()) T(std::move(data));
+    CommitSlot();
+  }
+
+  template <typename... Args>
+  T& Emplace(Args&&... args) {
+    T* slot = NextSlot();
+    new (slot) T(std::forward<Args>(args)...);
+    CommitSlot();
+    return *slot;
+  }
+
+  // 批量入栈 values[0..n)，values[n - 1] 成为新的栈顶
+  void PushN(const T* values, size_t n) {
+    while (n > 0) {
+      if (top_ == segments_[cur_].capacity) {
+        AdvanceSegment();
+      }
+      // 当前分段一次最多能放入的元素个数
+      size_t m = segments_[cur_].capacity - top_;
+      if (m > n) {
+        m = n;
+      }
+      T* dst = segments_[cur_].data + top_;
+      size_t i = 0;
+      try {
+        for (; i < m; i++) {
+          new (&dst[i]) T(values[i]);
+        }
+      } catch (...) {
+        // 已构造的元素保留在栈中，当前分段仍为空时回退，保证栈顶所在分段不为空
+        top_ += i;
+        size_ += i;
+        if (top_ == 0 && cur_ > 0) {
+          RetreatSegment();
+        }
+        throw;
+      }
+      top_ += m;
+      size_ += m;
+      values += m;
+      n -= m;
+    }
+  }
+
+  // 删
+  void Pop() {
+    if (Empty()) {
+      return;
+    }
+    top_--;
+    size_--;
+    segments_[cur_].data[top_].~T();
+    if (top_ == 0 && cur_ > 0) {
+      RetreatSegment();
+    }
+  }
+
+  // 批量出栈 n 个元素，n 大于栈中元素个数时清空栈
+  void PopN(size_t n) {
+    if (n > size_) {
+      n = size_;
+    }
+    while (n > 0) {
+      // 当前分段一次最多能弹出的元素个数
+      size_t m = top_ < n ? top_ : n;
+      T* data = segments_[cur_].data;
+      for (size_t i = top_ - m; i < top_; i++) {
+        data[i].~T();
+      }
+      top_ -= m;
+      size_ -= m;
+      n -= m;
+      if (top_ == 0 && cur_ > 0) {
+        RetreatSegment();
+      }
+    }
+  }
+
+  void Clear() { PopN(size_); }
+
+  // 查、改
+  T& Top() {
+    if (Empty()) throw std::out_of_range("stack is empty");
+    return segments_[cur_].data[top_ - 1];
+  }
+
+  const T& Top() const {
+    if (Empty()) throw std::out_of_range("stack is empty");
+    return segments_[cur_].data[top_ - 1];
+  }
+
+  // 工具函数
+  bool Empty() const { return size_ == 0; }
+
+  size_t Size() const { return size_; }
+
+  // 已分配的总容量（包括保留的空闲分段）
+  size_t Capacity() const {
+    size_t capacity = 0;
+    for (size_t i = 0; i < allocated_; i++) {
+      capacity += segments_[i].capacity;
+    }
+    return capacity;
+  }
+
+  // 释放当前分段之上保留的所有空闲分段
+  void ShrinkToFit() { ReleaseSegments(cur_ + 1); }
+
+ private:
+  struct Segment {
+    T* data{nullptr};
+    size_t capacity{0};
+  };
+
+  // 第 i 个分段的容量为 base_capacity_ * 2^i，64 个分段足以覆盖 size_t
+  static const size_t kMaxSegments_{64};
+
+  // 返回栈顶之上下一个可用槽位，当前分段已满时为下一个分段的第一个槽位（必要时分配）
+  // 不修改 cur_、top_、size_，构造元素成功后再调用 CommitSlot，构造抛出异常时栈保持不变
+  T* NextSlot() {
+    if (top_ < segments_[cur_].capacity) {
+      return &segments_[cur_].data[top_];
+    }
+    if (cur_ + 1 == allocated_) {
+      AllocSegment(allocated_);
+    }
+    return segments_[cur_ + 1].data;
+  }
+
+  // NextSlot 返回的槽位上已构造好元素，把它计入栈中
+  void CommitSlot() {
+    if (top_ == segments_[cur_].capacity) {
+      cur_++;
+      top_ = 0;
+    }
+    top_++;
+    size_++;
+  }
+
+  // 当前分段已满，切换到下一个分段
+  void AdvanceSegment() {
+    if (cur_ + 1 == allocated_) {
+      AllocSegment(allocated_);
+    }
+    cur_++;
+    top_ = 0;
+  }
+
+  // 当前分段已空，回退到前一个（已满的）分段
+  void RetreatSegment() {
+    cur_--;
+    top_ = segments_[cur_].capacity;
+    if (policy_ == RETAIN_ONE) {
+      ReleaseSegments(cur_ + 2);
+    } else if (policy_ == RELEASE) {
+      ReleaseSegments(cur_ + 1);
+    }
+  }
+
+  void AllocSegment(size_t i) {
+    if (i >= kMaxSegments_) {
+      throw std::length_error("too many segments");
+    }
+    size_t capacity = base_capacity_ << i;
+    if ((capacity >> i) != base_capacity_) {
+      throw std::length_error("segment capacity overflow");
+    }
+    // 不需要构造 T，只需要分配内存块
+    segments_[i].data = (T*)::operator new(capacity * sizeof(T));
+    segments_[i].capacity = capacity;
+    allocated_ = i + 1;
+  }
+
+  // 释放索引 [from, allocated_) 中的分段（这些分段中不存在元素）
+  void ReleaseSegments(size_t from) {
+    for (size_t i = from; i < allocated_; i++) {
+      // 避免调用T的析构函数
+      ::operator delete(segments_[i].data, segments_[i].capacity * sizeof(T));
+      segments_[i].data = nullptr;
+      segments_[i].capacity = 0;
+    }
+    if (from < allocated_) {
+      allocated_ = from;
+    }
+  }
+
+  Segment segments_[kMaxSegments_];
+  size_t allocated_{0};  // 已分配的分段个数
+  size_t cur_{0};        // 栈顶所在的分段
+  size_t top_{0};        // 栈顶所在分段中的元素个数
+  size_t size_{0};
+
+  size_t base_capacity_;
+  RetainPolicy policy_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_SEGMENTED_STACK_H
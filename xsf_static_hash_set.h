@@ -0,0 +1,156 @@
+#ifndef XSF_STATIC_HASH_SET_H
+#define XSF_STATIC_HASH_SET_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "xsf_array.h"
+
+namespace xsf_data_structures {
+
+// XSFStaticHashSet 默认的哈希函数，适用于整数和枚举类型
+// std::hash 不是 constexpr 的，这里用 MurmurHash3 的终结函数打散各个位，可在常量表达式中使用
+template <typename K>
+struct XSFStaticHash {
+  constexpr size_t operator()(const K& key) const {
+    static_assert(std::is_integral_v<K> || std::is_enum_v<K>,
+                  "XSFStaticHash only supports integral and enum keys");
+    uint64_t x = static_cast<uint64_t>(key);
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+  }
+};
+
+// 定容哈希集合，使用线性探查法解决冲突，从不分配堆内存
+// 容量 N 必须是 2 的指数，可以放在栈上或共享内存中
+// 删除时将后续探查链上的元素前移（backward shift），不留下删除标记
+// 因此反复增删也不会让探查链越来越长
+// 整数和枚举类型的键可以省略 Hash，使用 XSFStaticHash，整个集合可在常量表达式中使用
+template <typename K, size_t N, class Hash = XSFStaticHash<K>>
+class XSFStaticHashSet {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of 2");
+
+ public:
+  constexpr XSFStaticHashSet() = default;
+
+  // 增
+  constexpr bool Insert(const K& key) {
+    size_t index = HashIndex(key);
+    if (Probe(key, index)) {
+      return false;
+    }
+    CheckFull();
+    keys_[index] = key;
+    used_[index] = true;
+    size_++;
+    return true;
+  }
+
+  constexpr bool Insert(K&& key) {
+    size_t index = HashIndex(key);
+    if (Probe(key, index)) {
+      return false;
+    }
+    CheckFull();
+    keys_[index] = std::move(key);
+    used_[index] = true;
+    size_++;
+    return true;
+  }
+
+  // 删
+  constexpr bool Erase(const K& key) {
+    size_t i = HashIndex(key);
+    if (!Probe(key, i)) {
+      return false;
+    }
+    // i 是空出来的槽位，向后检查探查链上的元素能否前移到 i
+    used_[i] = false;
+    for (size_t j = (i + 1) & kMask_; used_[j]; j = (j + 1) & kMask_) {
+      size_t home = HashIndex(keys_[j]);
+      // home 位于循环区间 (i, j] 中时，前移会让 keys_[j] 无法被探查到
+      bool stay = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+      if (!stay) {
+        keys_[i] = std::move(keys_[j]);
+        used_[i] = true;
+        used_[j] = false;
+        i = j;
+      }
+    }
+    Reset(i);
+    size_--;
+    return true;
+  }
+
+  constexpr void Clear() {
+    for (size_t i = 0; i < N; i++) {
+      if (used_[i]) {
+        used_[i] = false;
+        Reset(i);
+      }
+    }
+    size_ = 0;
+  }
+
+  // 查
+  constexpr bool Contains(const K& key) const {
+    size_t index = HashIndex(key);
+    return Probe(key, index);
+  }
+
+  // 工具函数
+  constexpr bool Empty() const { return size_ == 0; }
+
+  constexpr bool Full() const { return size_ == N; }
+
+  constexpr size_t Size() const { return size_; }
+
+  constexpr size_t Capacity() const { return N; }
+
+ private:
+  static constexpr size_t kMask_{N - 1};
+
+  constexpr void CheckFull() const {
+    if (Full()) {
+      throw std::length_error("static hash set is full");
+    }
+  }
+
+  // 从 index 开始对 key 进行线性探查
+  // 找到时返回 true，index 为 key 所在槽位；否则 index 为第一个空槽位
+  constexpr bool Probe(const K& key, size_t& index) const {
+    for (size_t step = 0; step < N && used_[index]; step++) {
+      if (keys_[index] == key) {
+        return true;
+      }
+      index = (index + 1) & kMask_;
+    }
+    return false;
+  }
+
+  // 哈希函数，将键映射到 keys_ 的索引
+  constexpr size_t HashIndex(const K& key) const { return hash_(key) & kMask_; }
+
+  // 槽位不再使用时重置为默认值，及时释放元素持有的资源
+  constexpr void Reset(size_t index) {
+    if constexpr (!std::is_trivially_destructible_v<K>) {
+      keys_[index] = K{};
+    }
+  }
+
+  [[no_unique_address]] Hash hash_{};
+
+  XSFArray<K, N> keys_{};
+  XSFArray<bool, N> used_{};
+  size_t size_{0};
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_STATIC_HASH_SET_H
\ No newline at end of file
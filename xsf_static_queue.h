@@ -0,0 +1,126 @@
+#ifndef XSF_STATIC_QUEUE_H
+#define XSF_STATIC_QUEUE_H
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "xsf_array.h"
+
+namespace xsf_data_structures {
+
+// 定容队列，基于环形数组，元素直接存储在内部的 XSFArray 中，从不分配堆内存
+// 可以放在栈上或共享内存中，接口均可在常量表达式中使用
+template <typename T, size_t N>
+class XSFStaticQueue {
+  static_assert(N > 0, "capacity must be positive");
+
+ public:
+  constexpr XSFStaticQueue() = default;
+
+  // 增
+  constexpr void Push(const T& value) {
+    CheckFull();
+    data_[rear_] = value;
+    Forward(rear_);
+    size_++;
+  }
+
+  constexpr void Push(T&& value) {
+    CheckFull();
+    data_[rear_] = std::move(value);
+    Forward(rear_);
+    size_++;
+  }
+
+  template <typename... Args>
+  constexpr T& Emplace(Args&&... args) {
+    CheckFull();
+    T& slot = data_[rear_];
+    slot = T(std::forward<Args>(args)...);
+    Forward(rear_);
+    size_++;
+    return slot;
+  }
+
+  // 删
+  constexpr void Pop() {
+    if (Empty()) {
+      return;
+    }
+    Reset(front_);
+    Forward(front_);
+    size_--;
+  }
+
+  constexpr void Clear() {
+    while (!Empty()) {
+      Pop();
+    }
+    front_ = 0;
+    rear_ = 0;
+  }
+
+  // 查、改
+  constexpr T& Front() {
+    if (Empty()) throw std::out_of_range("queue is empty");
+    return data_[front_];
+  }
+
+  constexpr const T& Front() const {
+    if (Empty()) throw std::out_of_range("queue is empty");
+    return data_[front_];
+  }
+
+  constexpr T& Back() {
+    if (Empty()) throw std::out_of_range("queue is empty");
+    return data_[rear_ == 0 ? N - 1 : rear_ - 1];
+  }
+
+  constexpr const T& Back() const {
+    if (Empty()) throw std::out_of_range("queue is empty");
+    return data_[rear_ == 0 ? N - 1 : rear_ - 1];
+  }
+
+  // 工具函数
+  constexpr bool Empty() const { return size_ == 0; }
+
+  constexpr bool Full() const { return size_ == N; }
+
+  constexpr size_t Size() const { return size_; }
+
+  constexpr size_t Capacity() const { return N; }
+
+ private:
+  constexpr void CheckFull() const {
+    if (Full()) {
+      throw std::length_error("static queue is full");
+    }
+  }
+
+  // 索引向后移动一位，到达末尾时回到开头
+  constexpr void Forward(size_t& index) {
+    index++;
+    if (index == N) {
+      index = 0;
+    }
+  }
+
+  // 槽位不再使用时重置为默认值，及时释放元素持有的资源
+  constexpr void Reset(size_t index) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      data_[index] = T{};
+    }
+  }
+
+  XSFArray<T, N> data_{};
+  size_t size_{0};
+
+  // data_ 的索引区间 [front_, rear_) 存储着添加的元素
+  size_t front_{0};  // 头指针
+  size_t rear_{0};   // 尾指针，若队列不空，指向队列尾元素的下一个位置
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_STATIC_QUEUE_H
\ No newline at end of file
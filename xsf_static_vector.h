@@ -0,0 +1,136 @@
+#ifndef XSF_STATIC_VECTOR_H
+#define XSF_STATIC_VECTOR_H
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "xsf_array.h"
+
+namespace xsf_data_structures {
+
+// 定容变长数组，元素直接存储在内部的 XSFArray 中，从不分配堆内存
+// 可以放在栈上或共享内存中，接口均可在常量表达式中使用
+template <typename T, size_t N>
+class XSFStaticVector {
+ public:
+  using ValueType = T;
+  using Iterator = T*;
+  using ConstIterator = const T*;
+
+  constexpr XSFStaticVector() = default;
+
+  // 增
+  constexpr void PushBack(const T& value) {
+    CheckFull();
+    data_[size_] = value;
+    size_++;
+  }
+
+  constexpr void PushBack(T&& value) {
+    CheckFull();
+    data_[size_] = std::move(value);
+    size_++;
+  }
+
+  template <typename... Args>
+  constexpr T& EmplaceBack(Args&&... args) {
+    CheckFull();
+    data_[size_] = T(std::forward<Args>(args)...);
+    return data_[size_++];
+  }
+
+  // 删
+  constexpr void PopBack() {
+    if (Empty()) {
+      return;
+    }
+    size_--;
+    Reset(size_);
+  }
+
+  // 删除 index 处的元素，后面的元素依次前移
+  constexpr void Erase(size_t index) {
+    CheckElement(index);
+    for (size_t i = index + 1; i < size_; i++) {
+      data_[i - 1] = std::move(data_[i]);
+    }
+    size_--;
+    Reset(size_);
+  }
+
+  constexpr void Clear() {
+    for (size_t i = 0; i < size_; i++) {
+      Reset(i);
+    }
+    size_ = 0;
+  }
+
+  // 查、改
+  constexpr T& operator[](size_t index) {
+    CheckElement(index);
+    return data_[index];
+  }
+
+  constexpr const T& operator[](size_t index) const {
+    CheckElement(index);
+    return data_[index];
+  }
+
+  constexpr Iterator begin() { return data_.Data(); }
+
+  constexpr ConstIterator begin() const { return data_.Data(); }
+
+  constexpr Iterator end() { return data_.Data() + size_; }
+
+  constexpr ConstIterator end() const { return data_.Data() + size_; }
+
+  constexpr T& Front() { return (*this)[0]; }
+
+  constexpr const T& Front() const { return (*this)[0]; }
+
+  constexpr T& Back() { return (*this)[size_ - 1]; }
+
+  constexpr const T& Back() const { return (*this)[size_ - 1]; }
+
+  constexpr T* Data() { return data_.Data(); }
+
+  constexpr const T* Data() const { return data_.Data(); }
+
+  // 工具函数
+  constexpr bool Empty() const { return size_ == 0; }
+
+  constexpr bool Full() const { return size_ == N; }
+
+  constexpr size_t Size() const { return size_; }
+
+  constexpr size_t Capacity() const { return N; }
+
+ private:
+  constexpr void CheckFull() const {
+    if (Full()) {
+      throw std::length_error("static vector is full");
+    }
+  }
+
+  // 检查 index 索引位置是否存在元素
+  constexpr void CheckElement(size_t index) const {
+    if (index >= size_) {
+      throw std::out_of_range("Index out of range");
+    }
+  }
+
+  // 槽位不再使用时重置为默认值，及时释放元素持有的资源
+  constexpr void Reset(size_t index) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      data_[index] = T{};
+    }
+  }
+
+  XSFArray<T, N> data_{};
+  size_t size_{0};
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_STATIC_VECTOR_H
\ No newline at end of file
@@ -0,0 +1,311 @@
+#ifndef XSF_TOP_K_TRIE_H
+#define XSF_TOP_K_TRIE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "xsf_trie_map.h"
+
+namespace xsf_data_structures {
+
+// 带分数的前缀树，用于按分数排序的前缀自动补全
+// 每个节点缓存以它为前缀的所有键中分数最高的 K 个（按分数从高到低排列）
+// 插入、修改分数、删除时只更新从该键到根节点路径上的缓存
+// 因此查询前缀的前 K 个补全只需 O(前缀长度 + K * 键长)，与子树大小无关
+// 子节点按字符从小到大存储在有序数组中，节点大小与实际的分叉数成正比
+// 分数相同的键之间的顺序不确定
+template <typename S, size_t K = 10>
+class XSFTopKTrie {
+  static_assert(K > 0, "K must be positive");
+
+ private:
+  struct Node;
+
+  // 缓存的一个补全，node 是该键的末尾节点
+  struct Entry {
+    S score{};
+    Node* node{nullptr};
+  };
+
+  struct Node {
+    Node* parent{nullptr};
+    unsigned char label{0};  // 从父节点到该节点的字符
+    bool has_score{false};   // 是否有键在该节点结束
+    S score{};
+    std::vector<std::pair<unsigned char, Node*>> children;
+    Entry top[K];
+    size_t top_count{0};
+  };
+
+ public:
+  XSFTopKTrie() = default;
+
+  XSFTopKTrie(const XSFTopKTrie&) = delete;
+  XSFTopKTrie& operator=(const XSFTopKTrie&) = delete;
+
+  ~XSFTopKTrie() { Clear(root_); }
+
+  // 以 XSFTrieMap 中的值作为分数构建，替换当前内容
+  template <class Alphabet>
+  void Build(const XSFTrieMap<S, Alphabet>& trie) {
+    Clear();
+    trie.ForEach([this](const std::string& key, const S& score) {
+      Set(key, score);
+    });
+  }
+
+  // 增、改，设置 key 的分数
+  void Set(const std::string& key, const S& score) {
+    Node* node = root_;
+    for (char c : key) {
+      node = GetOrCreateChild(node, static_cast<unsigned char>(c));
+    }
+    if (!node->has_score) {
+      node->has_score = true;
+      node->score = score;
+      size_++;
+      Promote(node);
+    } else if (node->score < score) {
+      node->score = score;
+      Promote(node);
+    } else if (score < node->score) {
+      node->score = score;
+      Demote(node);
+    }
+  }
+
+  // 把 key 的分数增加 delta，key 不存在时视为从 S{} 开始，常用于统计频率
+  void Increment(const std::string& key, const S& delta = S{1}) {
+    S score{};
+    Score(key, score);
+    Set(key, score + delta);
+  }
+
+  // 删
+  void Erase(const std::string& key) {
+    Node* node = FindNode(key);
+    if (node == nullptr || !node->has_score) {
+      return;
+    }
+    node->has_score = false;
+    size_--;
+    // 自底向上清理既没有分数也没有子节点的节点
+    while (node != root_ && !node->has_score && node->children.empty()) {
+      Node* parent = node->parent;
+      RemoveChild(parent, node->label);
+      delete node;
+      node = parent;
+    }
+    // 路径上的缓存可能包含被删除的键，全部重新计算
+    for (; node != nullptr; node = node->parent) {
+      Recompute(node);
+    }
+  }
+
+  void Clear() {
+    Clear(root_);
+    root_ = new Node();
+    size_ = 0;
+  }
+
+  // 查，找到时把分数复制到 result 中
+  bool Score(const std::string& key, S& result) const {
+    Node* node = FindNode(key);
+    if (node == nullptr || !node->has_score) {
+      return false;
+    }
+    result = node->score;
+    return true;
+  }
+
+  bool Contains(const std::string& key) const {
+    Node* node = FindNode(key);
+    return node != nullptr && node->has_score;
+  }
+
+  // 按分数从高到低，对前缀为 prefix 的前 limit 个键调用 visitor(key, score)
+  // limit 最大为 K，返回调用 visitor 的次数
+  template <typename Visitor>
+  size_t VisitTopK(const std::string& prefix, Visitor&& visitor,
+                   size_t limit = K) const {
+    Node* node = FindNode(prefix);
+    if (node == nullptr) {
+      return 0;
+    }
+    size_t n = std::min(limit, node->top_count);
+    std::string key;
+    for (size_t i = 0; i < n; i++) {
+      BuildKey(node->top[i].node, key);
+      visitor(static_cast<const std::string&>(key),
+              static_cast<const S&>(node->top[i].score));
+    }
+    return n;
+  }
+
+  // 按分数从高到低返回前缀为 prefix 的前 limit 个键及其分数
+  std::vector<std::pair<std::string, S>> TopK(const std::string& prefix,
+                                              size_t limit = K) const {
+    std::vector<std::pair<std::string, S>> result;
+    VisitTopK(
+        prefix,
+        [&result](const std::string& key, const S& score) {
+          result.emplace_back(key, score);
+        },
+        limit);
+    return result;
+  }
+
+  // 工具函数
+  size_t Size() const { return size_; }
+
+  bool Empty() const { return size_ == 0; }
+
+ private:
+  Node* FindNode(const std::string& key) const {
+    Node* node = root_;
+    for (char c : key) {
+      node = FindChild(node, static_cast<unsigned char>(c));
+      if (node == nullptr) {
+        return nullptr;
+      }
+    }
+    return node;
+  }
+
+  // 在 node 的有序子节点数组中二分查找字符 c
+  typename std::vector<std::pair<unsigned char, Node*>>::iterator
+  LowerBound(Node* node, unsigned char c) const {
+    return std::lower_bound(
+        node->children.begin(), node->children.end(), c,
+        [](const std::pair<unsigned char, Node*>& child, unsigned char label) {
+          return child.first < label;
+        });
+  }
+
+  Node* FindChild(Node* node, unsigned char c) const {
+    auto it = LowerBound(node, c);
+    if (it == node->children.end() || it->first != c) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  Node* GetOrCreateChild(Node* node, unsigned char c) {
+    auto it = LowerBound(node, c);
+    if (it != node->children.end() && it->first == c) {
+      return it->second;
+    }
+    Node* child = new Node();
+    child->parent = node;
+    child->label = c;
+    node->children.insert(it, {c, child});
+    return child;
+  }
+
+  void RemoveChild(Node* node, unsigned char c) {
+    node->children.erase(LowerBound(node, c));
+  }
+
+  // 从末尾节点沿父指针还原出完整的键
+  void BuildKey(Node* node, std::string& key) const {
+    key.clear();
+    for (; node != root_; node = node->parent) {
+      key.push_back(static_cast<char>(node->label));
+    }
+    std::reverse(key.begin(), key.end());
+  }
+
+  // 尝试把 entry 放入 node 的缓存（entry 不在缓存中），缓存已满且分数不够高时放弃
+  // 返回是否放入
+  bool Offer(Node* node, const Entry& entry) {
+    size_t i = node->top_count;
+    if (i == K) {
+      if (!(node->top[K - 1].score < entry.score)) {
+        return false;
+      }
+      i--;
+    } else {
+      node->top_count++;
+    }
+    // 插入排序，保持分数从高到低
+    while (i > 0 && node->top[i - 1].score < entry.score) {
+      node->top[i] = node->top[i - 1];
+      i--;
+    }
+    node->top[i] = entry;
+    return true;
+  }
+
+  // 返回 target 在 node 缓存中的位置，不存在时返回 top_count
+  size_t IndexOf(Node* node, Node* target) const {
+    size_t i = 0;
+    while (i < node->top_count && node->top[i].node != target) {
+      i++;
+    }
+    return i;
+  }
+
+  // target 的分数变高（或新插入），自底向上更新路径上的缓存
+  // 某个节点的缓存放不下 target 时，祖先节点的缓存也放不下，可以提前结束
+  void Promote(Node* target) {
+    Entry entry{target->score, target};
+    for (Node* node = target; node != nullptr; node = node->parent) {
+      size_t i = IndexOf(node, target);
+      if (i < node->top_count) {
+        // 已在缓存中，更新分数后向前调整位置
+        while (i > 0 && node->top[i - 1].score < entry.score) {
+          node->top[i] = node->top[i - 1];
+          i--;
+        }
+        node->top[i] = entry;
+      } else if (!Offer(node, entry)) {
+        return;
+      }
+    }
+  }
+
+  // target 的分数变低，原先被挤出缓存的键可能重新进入，需要重新计算
+  // 某个节点的缓存中没有 target 时，祖先节点的缓存中也没有，可以提前结束
+  void Demote(Node* target) {
+    for (Node* node = target; node != nullptr; node = node->parent) {
+      if (IndexOf(node, target) == node->top_count) {
+        return;
+      }
+      Recompute(node);
+    }
+  }
+
+  // 由 node 自身的分数和所有子节点的缓存重新计算 node 的缓存
+  void Recompute(Node* node) {
+    node->top_count = 0;
+    if (node->has_score) {
+      Offer(node, Entry{node->score, node});
+    }
+    for (const auto& [c, child] : node->children) {
+      for (size_t i = 0; i < child->top_count; i++) {
+        if (!Offer(node, child->top[i])) {
+          // 子节点的缓存有序，后面的分数只会更低
+          break;
+        }
+      }
+    }
+  }
+
+  // 删除以 node 为根的子树
+  void Clear(Node* node) {
+    for (const auto& [c, child] : node->children) {
+      Clear(child);
+    }
+    delete node;
+  }
+
+  size_t size_{0};
+  Node* root_{new Node()};
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_TOP_K_TRIE_H
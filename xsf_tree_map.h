@@ -1,14 +1,20 @@
 #ifndef XSF_TREE_MAP_H
 #define XSF_TREE_MAP_H
 
+#include <cmath>
+#include <cstddef>
+#include <iterator>
 #include <list>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace xsf_data_structures {
 
-// 以普通 BST 为底层实现的 map
-template <typename K, typename V, class Compare>
+// 以 BST 为底层实现的 map
+// Balanced 为 false 时是普通 BST；为 true 时是 AVL 树，有序插入也能保持 O(logN) 的高度
+template <typename K, typename V, class Compare, bool Balanced = false>
 class XSFTreeMap {
  private:
   struct Node {
@@ -16,8 +22,12 @@ class XSFTreeMap {
     V value{};
     Node* left{nullptr};
     Node* right{nullptr};
+    // 父节点，用于迭代器寻找前驱、后继
+    Node* parent{nullptr};
     // 记录以该节点为根的 BST 有多少个节点
     size_t size_{1};
+    // 记录以该节点为根的 BST 的高度，叶子节点的高度为 1
+    size_t height_{1};
 
     Node() = default;
 
@@ -36,7 +46,80 @@ class XSFTreeMap {
     Node(const Node&) = default;
   };
 
+  // 双向迭代器，按键从小到大的顺序遍历，Const 为 true 时不能修改 value
+  // 解引用得到键，Value() 得到值；end() 的节点为 null
+  template <bool Const>
+  class BasicIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = K;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const K*;
+    using reference = const K&;
+    using ValueReference = std::conditional_t<Const, const V&, V&>;
+
+    BasicIterator() = default;
+
+    BasicIterator(const BasicIterator&) = default;
+
+    BasicIterator& operator=(const BasicIterator&) = default;
+
+    // 允许从非 const 迭代器转换为 const 迭代器
+    // 限定 Const 为 true，否则它会成为 Iterator 的复制构造函数
+    BasicIterator(const BasicIterator<false>& other)
+      requires Const
+        : node_(other.node_), map_(other.map_) {}
+
+    const K& operator*() const { return node_->key; }
+
+    const K* operator->() const { return &node_->key; }
+
+    const K& Key() const { return node_->key; }
+
+    ValueReference Value() const { return node_->value; }
+
+    BasicIterator& operator++() {
+      node_ = map_->Successor(node_);
+      return *this;
+    }
+
+    BasicIterator operator++(int) {
+      BasicIterator old{*this};
+      ++(*this);
+      return old;
+    }
+
+    BasicIterator& operator--() {
+      node_ = map_->Predecessor(node_);
+      return *this;
+    }
+
+    BasicIterator operator--(int) {
+      BasicIterator old{*this};
+      --(*this);
+      return old;
+    }
+
+    bool operator==(const BasicIterator& rhs) const {
+      return node_ == rhs.node_;
+    }
+
+    bool operator!=(const BasicIterator& rhs) const { return !(*this == rhs); }
+
+   private:
+    BasicIterator(Node* node, const XSFTreeMap* map) : node_(node), map_(map) {}
+
+    Node* node_{nullptr};
+    const XSFTreeMap* map_{nullptr};
+
+    friend class XSFTreeMap;
+    friend class BasicIterator<!Const>;
+  };
+
  public:
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
   XSFTreeMap() = default;
 
   ~XSFTreeMap() { Clear(); }
@@ -44,24 +127,97 @@ class XSFTreeMap {
   // 增、改
   V& operator[](const K& key) {
     auto [new_root, new_value] = InsertNode(root_, key);
-    root_ = new_root;
+    SetRoot(new_root);
     return new_value;
   }
 
   V& operator[](K&& key) {
     auto [new_root, new_value] = InsertNode(root_, std::forward<K>(key));
-    root_ = new_root;
+    SetRoot(new_root);
     return new_value;
   }
 
+  // 用区间 [first, last) 中按键严格递增排列的键值对（first、second）替换当前内容
+  // O(N) 构建一棵完全平衡的树，区间未按键严格递增排列时抛出异常
+  template <typename ForwardIt>
+  void BuildFromSorted(ForwardIt first, ForwardIt last) {
+    // 先检查区间，确保出错时不修改当前内容
+    size_t n = 0;
+    for (ForwardIt prev = first, it = first; it != last; prev = it++, n++) {
+      if (n > 0 && !compare_(prev->first, it->first)) {
+        throw std::invalid_argument("keys are not strictly increasing");
+      }
+    }
+    Clear();
+    SetRoot(BuildFromSorted(first, n));
+  }
+
+  // 将 other 中的键值对并入当前 map，键相同时保留当前 map 的值
+  // 两棵树都先展平为有序链表，归并后再构建为完全平衡的树，O(N + M)
+  // 节点直接从 other 中移动过来，不重新分配，完成后 other 为空
+  void MergeFrom(XSFTreeMap& other) {
+    if (this == &other) {
+      return;
+    }
+    Node* a = Flatten(root_);
+    Node* b = Flatten(other.root_);
+    other.root_ = nullptr;
+
+    // 归并两条以 right 相连的有序链表
+    Node head;
+    Node* tail = &head;
+    size_t n = 0;
+    while (a != nullptr && b != nullptr) {
+      if (compare_(a->key, b->key)) {
+        tail->right = a;
+        a = a->right;
+      } else if (compare_(b->key, a->key)) {
+        tail->right = b;
+        b = b->right;
+      } else {
+        // 键相同，保留当前 map 的节点
+        Node* duplicate = b;
+        b = b->right;
+        delete duplicate;
+        continue;
+      }
+      tail = tail->right;
+      n++;
+    }
+    tail->right = (a != nullptr) ? a : b;
+    for (Node* node = tail->right; node != nullptr; node = node->right) {
+      n++;
+    }
+
+    Node* list = head.right;
+    SetRoot(BuildFromList(list, n));
+  }
+
   // 删
-  void EraseMax() { root_ = EraseMax(root_); }
+  void EraseMax() {
+    if (root_ != nullptr) {
+      SetRoot(EraseMax(root_));
+    }
+  }
 
-  void EraseMin() { root_ = EraseMin(root_); }
+  void EraseMin() {
+    if (root_ != nullptr) {
+      SetRoot(EraseMin(root_));
+    }
+  }
 
-  void Erase(const K& key) { root_ = Erase(root_, key); }
+  void Erase(const K& key) { SetRoot(Erase(root_, key)); }
 
-  void Erase(K&& key) { root_ = Erase(root_, std::forward<K>(key)); }
+  void Erase(K&& key) { SetRoot(Erase(root_, std::forward<K>(key))); }
+
+  // 删除 pos 指向的键值对，返回其后继的迭代器
+  // 只有指向被删除键值对的迭代器失效，其他迭代器仍然有效
+  Iterator Erase(Iterator pos) {
+    // 删除只释放 pos 的节点，后继节点不受影响
+    Node* next = Successor(pos.node_);
+    Erase(pos.node_->key);
+    return Iterator(next, this);
+  }
 
   void Clear() {
     Clear(root_);
@@ -123,27 +279,117 @@ class XSFTreeMap {
     if (i >= Size()) {
       throw std::out_of_range("Index out of range");
     }
+    return Select(root_, i)->key;
+  }
+
+  // 返回闭区间 [lo, hi] 中的键的个数（仅提供左值引用版本）
+  size_t CountInRange(const K& lo, const K& hi) const {
+    if (compare_(hi, lo)) {
+      return 0;
+    }
+    size_t count = Rank(root_, hi) - Rank(root_, lo);
+    if (FindNode(root_, hi) != nullptr) {
+      count++;
+    }
+    return count;
+  }
+
+  // 返回闭区间 [lo, hi] 中索引为 k 的键，k 从 0 开始计算（仅提供左值引用版本）
+  K KthInRange(const K& lo, const K& hi, size_t k) const {
+    if (k >= CountInRange(lo, hi)) {
+      throw std::out_of_range("Index out of range");
+    }
+    return Select(root_, Rank(root_, lo) + k)->key;
+  }
+
+  // 返回分位数 q 对应的键（最近秩法），q 的取值范围为 [0, 1]
+  // 比如 Quantile(0.99) 返回 P99，Quantile(0.5) 返回中位数
+  K Quantile(double q) const {
+    if (!(q >= 0.0 && q <= 1.0)) {
+      throw std::out_of_range("Quantile out of range");
+    }
+    size_t n = Size();
+    if (n == 0) {
+      throw std::out_of_range("map is empty");
+    }
+    // 第 ceil(q * n) 小的键，q 为 0 时取最小键
+    size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(n)));
+    if (rank == 0) {
+      rank = 1;
+    }
+    if (rank > n) {
+      rank = n;
+    }
+    return Select(root_, rank - 1)->key;
   }
 
   // 工具函数
   size_t Size() const { return Size(root_); }
 
+  // 返回树的高度，空树的高度为 0
+  size_t Height() const { return Height(root_); }
+
   bool Empty() const { return root_ == nullptr; }
 
   // 从小到大返回所有键
   std::vector<K> Keys() const {
-    std::vector<K> keys(Size());
+    std::vector<K> keys;
+    keys.reserve(Size());
     InOrderTraverse(root_, keys);
     return keys;
   }
 
   // 从小到大返回闭区间 [min, max] 中的键（仅提供左值引用版本）
+  // 只需遍历部分键或提前结束时，使用 LowerBound、UpperBound 返回的迭代器
   std::list<K> Keys(const K& min, const K& max) const {
     std::list<K> keys;
-    Keys(root_, keys, min, max);
+    InOrderTraverse(root_, keys, min, max);
     return keys;
   }
 
+  // 迭代器
+  Iterator begin() { return Iterator(FindMin(root_), this); }
+
+  ConstIterator begin() const { return ConstIterator(FindMin(root_), this); }
+
+  Iterator end() { return Iterator(nullptr, this); }
+
+  ConstIterator end() const { return ConstIterator(nullptr, this); }
+
+  // 返回 key 对应的迭代器，不存在时返回 end()
+  Iterator Find(const K& key) { return Iterator(FindNode(root_, key), this); }
+
+  ConstIterator Find(const K& key) const {
+    return ConstIterator(FindNode(root_, key), this);
+  }
+
+  // 返回指向第一个大于等于 key 的键的迭代器
+  Iterator LowerBound(const K& key) {
+    return Iterator(LowerBoundNode(key), this);
+  }
+
+  ConstIterator LowerBound(const K& key) const {
+    return ConstIterator(LowerBoundNode(key), this);
+  }
+
+  // 返回指向第一个大于 key 的键的迭代器
+  Iterator UpperBound(const K& key) {
+    return Iterator(UpperBoundNode(key), this);
+  }
+
+  ConstIterator UpperBound(const K& key) const {
+    return ConstIterator(UpperBoundNode(key), this);
+  }
+
+  // 返回键等于 key 的迭代器区间 [LowerBound(key), UpperBound(key))
+  std::pair<Iterator, Iterator> EqualRange(const K& key) {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  std::pair<ConstIterator, ConstIterator> EqualRange(const K& key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
  private:
   // 在以 node 为根的 BST 中插入一个新节点
   // 返回插入后的根节点、新节点的 value 的引用
@@ -156,14 +402,12 @@ class XSFTreeMap {
       // key < node->key
       auto [new_left, new_value] = InsertNode(node->left, key);
       node->left = new_left;
-      node->size_ = Size(node->left) + 1 + Size(node->right);
-      return {node, new_value};
+      return {Balance(node), new_value};
     } else if (compare_(node->key, key)) {
       // key > node->key
       auto [new_right, new_value] = InsertNode(node->right, key);
       node->right = new_right;
-      node->size_ = Size(node->left) + 1 + Size(node->right);
-      return {node, new_value};
+      return {Balance(node), new_value};
     } else {
       // key == node->key
       return {node, node->value};
@@ -179,15 +423,13 @@ class XSFTreeMap {
       // key < node->key
       auto [new_left, new_value] = InsertNode(node->left, std::forward<K>(key));
       node->left = new_left;
-      node->size_ = Size(node->left) + 1 + Size(node->right);
-      return {node, new_value};
+      return {Balance(node), new_value};
     } else if (compare_(node->key, key)) {
       // key > node->key
       auto [new_right, new_value] =
           InsertNode(node->right, std::forward<K>(key));
       node->right = new_right;
-      node->size_ = Size(node->left) + 1 + Size(node->right);
-      return {node, new_value};
+      return {Balance(node), new_value};
     } else {
       // key == node->key
       return {node, node->value};
@@ -203,8 +445,19 @@ class XSFTreeMap {
       return left;
     }
     node->right = EraseMax(node->right);
-    node->size_--;
-    return node;
+    return Balance(node);
+  }
+
+  // 从以 node 为根的 BST 中摘下最大节点但不释放，通过 max 返回
+  // 返回摘除后的根节点
+  Node* DetachMax(Node* node, Node*& max) {
+    if (node->right == nullptr) {
+      // node 就是最大节点
+      max = node;
+      return node->left;
+    }
+    node->right = DetachMax(node->right, max);
+    return Balance(node);
   }
 
   // 删除以 node 为根的 BST 中的最小节点
@@ -216,8 +469,7 @@ class XSFTreeMap {
       return right;
     }
     node->left = EraseMin(node->left);
-    node->size_--;
-    return node;
+    return Balance(node);
   }
 
   // 删除以 node 为根的 BST 中 key 对应的节点
@@ -248,16 +500,15 @@ class XSFTreeMap {
       }
       // node 有左右子树
       // 不直接交换节点中的数据，而是交换节点，实现解耦
-      // 复制左子树的最大节点作为新的根节点
-      Node* left_max{new Node(*FindMax(node->left))};
-      // 删除左子树的最大节点，并用 left_max 替换 node
-      left_max->left = EraseMax(node->left);
+      // 把左子树的最大节点摘下来替换 node，不复制节点，指向它的迭代器仍然有效
+      Node* left_max{nullptr};
+      Node* left = DetachMax(node->left, left_max);
+      left_max->left = left;
       left_max->right = node->right;
       delete node;
       node = left_max;
     }
-    node->size_ = Size(node->left) + 1 + Size(node->right);
-    return node;
+    return Balance(node);
   }
 
   Node* Erase(Node* node, K&& key) {
@@ -287,15 +538,67 @@ class XSFTreeMap {
       }
       // node 有左右子树
       // 不直接交换节点中的数据，而是交换节点，实现解耦
-      // 复制左子树的最大节点作为新的根节点
-      Node* left_max{new Node(*FindMax(node->left))};
-      // 删除左子树的最大节点，并用 left_max 替换 node
-      left_max->left = EraseMax(node->left);
+      // 把左子树的最大节点摘下来替换 node，不复制节点，指向它的迭代器仍然有效
+      Node* left_max{nullptr};
+      Node* left = DetachMax(node->left, left_max);
+      left_max->left = left;
       left_max->right = node->right;
       delete node;
       node = left_max;
     }
-    node->size_ = Size(node->left) + 1 + Size(node->right);
+    return Balance(node);
+  }
+
+  // 用从 it 开始的 n 个有序键值对构建完全平衡的树，it 移动到第 n 个之后
+  template <typename ForwardIt>
+  Node* BuildFromSorted(ForwardIt& it, size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+    // 中序构建：先左子树，再根节点，最后右子树
+    Node* left = BuildFromSorted(it, n / 2);
+    Node* node = new Node(it->first, it->second, left, nullptr, 1);
+    ++it;
+    node->right = BuildFromSorted(it, n - n / 2 - 1);
+    Update(node);
+    return node;
+  }
+
+  // 将以 node 为根的 BST 通过右旋展平为以 right 相连的有序链表（DSW 算法）
+  // 返回链表头，不使用递归，普通 BST 退化时也不会栈溢出
+  Node* Flatten(Node* node) {
+    Node head;
+    head.right = node;
+    Node* tail = &head;
+    Node* rest = node;
+    while (rest != nullptr) {
+      if (rest->left == nullptr) {
+        tail = rest;
+        rest = rest->right;
+      } else {
+        // 右旋，把左子节点提到 rest 的位置
+        Node* left = rest->left;
+        rest->left = left->right;
+        left->right = rest;
+        rest = left;
+        tail->right = left;
+      }
+    }
+    return head.right;
+  }
+
+  // 用以 right 相连的有序链表 list 的前 n 个节点构建完全平衡的树
+  // list 移动到第 n 个节点之后
+  Node* BuildFromList(Node*& list, size_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+    Node* left = BuildFromList(list, n / 2);
+    Node* node = list;
+    list = list->right;
+    node->left = left;
+    node->right = BuildFromList(list, n - n / 2 - 1);
+    Update(node);
     return node;
   }
 
@@ -310,15 +613,92 @@ class XSFTreeMap {
   }
 
   // 在以 node 为根的 BST 中查找最大节点
-  Node* FindMax(Node* node) {
+  Node* FindMax(Node* node) const {
     while (node->right != nullptr) {
       node = node->right;
     }
     return node;
   }
 
+  // 在以 node 为根的 BST 中查找最小节点，node 为 null 时返回 null
+  Node* FindMin(Node* node) const {
+    if (node == nullptr) {
+      return nullptr;
+    }
+    while (node->left != nullptr) {
+      node = node->left;
+    }
+    return node;
+  }
+
+  // 返回 node 的后继节点，node 为最大节点时返回 null
+  Node* Successor(Node* node) const {
+    if (node->right != nullptr) {
+      // 右子树中的最小节点
+      return FindMin(node->right);
+    }
+    // 向上找到第一个以 node 所在子树为左子树的祖先
+    Node* parent = node->parent;
+    while (parent != nullptr && node == parent->right) {
+      node = parent;
+      parent = parent->parent;
+    }
+    return parent;
+  }
+
+  // 返回 node 的前驱节点，node 为 null（即 end()）时返回最大节点
+  Node* Predecessor(Node* node) const {
+    if (node == nullptr) {
+      return root_ == nullptr ? nullptr : FindMax(root_);
+    }
+    if (node->left != nullptr) {
+      // 左子树中的最大节点
+      return FindMax(node->left);
+    }
+    // 向上找到第一个以 node 所在子树为右子树的祖先
+    Node* parent = node->parent;
+    while (parent != nullptr && node == parent->left) {
+      node = parent;
+      parent = parent->parent;
+    }
+    return parent;
+  }
+
+  // 查找第一个大于等于 key 的节点
+  Node* LowerBoundNode(const K& key) const {
+    Node* result = nullptr;
+    Node* node = root_;
+    while (node != nullptr) {
+      if (compare_(node->key, key)) {
+        // node->key < key，去右子树找
+        node = node->right;
+      } else {
+        // node->key >= key，node 是候选，继续去左子树找更小的
+        result = node;
+        node = node->left;
+      }
+    }
+    return result;
+  }
+
+  // 查找第一个大于 key 的节点
+  Node* UpperBoundNode(const K& key) const {
+    Node* result = nullptr;
+    Node* node = root_;
+    while (node != nullptr) {
+      if (compare_(key, node->key)) {
+        // key < node->key，node 是候选，继续去左子树找更小的
+        result = node;
+        node = node->left;
+      } else {
+        node = node->right;
+      }
+    }
+    return result;
+  }
+
   // 在以 node 为根的 BST 中查找 key 对应的节点
-  Node* FindNode(Node* node, const K& key) {
+  Node* FindNode(Node* node, const K& key) const {
     if (node == nullptr) {
       // key 对应的节点不存在
       return nullptr;
@@ -335,7 +715,7 @@ class XSFTreeMap {
     }
   }
 
-  Node* FindNode(Node* node, K&& key) {
+  Node* FindNode(Node* node, K&& key) const {
     if (node == nullptr) {
       // key 对应的节点不存在
       return nullptr;
@@ -541,6 +921,82 @@ class XSFTreeMap {
     return node->size_;
   }
 
+  void SetRoot(Node* node) {
+    root_ = node;
+    if (root_ != nullptr) {
+      root_->parent = nullptr;
+    }
+  }
+
+  size_t Height(Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    return node->height_;
+  }
+
+  // 根据左右子树重新计算 node 的 size_ 和 height_，并修正子节点的 parent
+  void Update(Node* node) {
+    if (node->left != nullptr) {
+      node->left->parent = node;
+    }
+    if (node->right != nullptr) {
+      node->right->parent = node;
+    }
+    node->size_ = Size(node->left) + 1 + Size(node->right);
+    size_t left_height = Height(node->left);
+    size_t right_height = Height(node->right);
+    node->height_ = (left_height > right_height ? left_height : right_height) + 1;
+  }
+
+  // 左旋，node 的右子节点成为新的根节点，返回旋转后的根节点
+  Node* RotateLeft(Node* node) {
+    Node* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    Update(node);
+    Update(right);
+    return right;
+  }
+
+  // 右旋，node 的左子节点成为新的根节点，返回旋转后的根节点
+  Node* RotateRight(Node* node) {
+    Node* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    Update(node);
+    Update(left);
+    return left;
+  }
+
+  // 在 node 的子树发生变化后调用，更新 size_、height_
+  // 平衡模式下，若左右子树高度差超过 1，通过旋转恢复平衡
+  // 返回调整后的根节点
+  Node* Balance(Node* node) {
+    Update(node);
+    if constexpr (Balanced) {
+      size_t left_height = Height(node->left);
+      size_t right_height = Height(node->right);
+      if (left_height > right_height + 1) {
+        // 左子树过高
+        if (Height(node->left->left) < Height(node->left->right)) {
+          // LR 型，先将左子树左旋转化为 LL 型
+          node->left = RotateLeft(node->left);
+        }
+        return RotateRight(node);
+      }
+      if (right_height > left_height + 1) {
+        // 右子树过高
+        if (Height(node->right->right) < Height(node->right->left)) {
+          // RL 型，先将右子树右旋转化为 RR 型
+          node->right = RotateRight(node->right);
+        }
+        return RotateLeft(node);
+      }
+    }
+    return node;
+  }
+
   Compare compare_{};
   Node* root_{nullptr};
 };
@@ -0,0 +1,132 @@
+#ifndef XSF_TRIE_ALPHABET_H
+#define XSF_TRIE_ALPHABET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace xsf_data_structures {
+
+// 前缀树的字母表策略，作为 XSFTrieMap 的模板参数，决定每个节点 children 数组的大小
+// 一个字母表需要提供：
+// 1. kSize：字符的个数
+// 2. ToIndex(c)：把字符映射到 [0, kSize)，不属于字母表的字符返回 kSize
+// 3. ToChar(i)：ToIndex 的逆映射
+// 字母表越小，节点越小，例如 DNA 序列只需 4 个子节点指针，而不是 256 个
+
+// 默认字母表，按无符号字节处理，可以包含任意字符
+struct XSFByteAlphabet {
+  static constexpr size_t kSize{256};
+
+  static size_t ToIndex(char c) { return static_cast<unsigned char>(c); }
+
+  static char ToChar(size_t i) { return static_cast<char>(i); }
+};
+
+// 由连续字符 [First, Last] 组成的字母表
+template <char First, char Last>
+struct XSFRangeAlphabet {
+  static_assert(First <= Last, "invalid character range");
+
+  static constexpr size_t kSize{static_cast<size_t>(Last - First) + 1};
+
+  static size_t ToIndex(char c) {
+    return (c < First || c > Last) ? kSize : static_cast<size_t>(c - First);
+  }
+
+  static char ToChar(size_t i) { return static_cast<char>(First + i); }
+};
+
+// 只包含小写字母的字母表
+using XSFLowercaseAlphabet = XSFRangeAlphabet<'a', 'z'>;
+
+// 只包含数字的字母表
+using XSFDigitAlphabet = XSFRangeAlphabet<'0', '9'>;
+
+// DNA 字母表，只包含 A、C、G、T
+struct XSFDNAAlphabet {
+  static constexpr size_t kSize{4};
+
+  static size_t ToIndex(char c) {
+    switch (c) {
+      case 'A':
+        return 0;
+      case 'C':
+        return 1;
+      case 'G':
+        return 2;
+      case 'T':
+        return 3;
+      default:
+        return kSize;
+    }
+  }
+
+  static char ToChar(size_t i) { return "ACGT"[i]; }
+};
+
+// 键的编码策略，作为 XSFRadixTrieMap 的模板参数
+// 基数树始终按字节分叉、按字节压缩路径，编码只决定一个“字符”由几个字节组成：
+// 1. Valid(key)：key 是否是合法的编码，插入不合法的键时抛出异常
+// 2. SymbolLength(lead)：以字节 lead 开头的字符占几个字节
+// 通配符 . 匹配一个完整的字符
+
+// 默认编码，每个字节是一个字符
+struct XSFByteEncoding {
+  static bool Valid(const std::string&) { return true; }
+
+  static size_t SymbolLength(uint8_t) { return 1; }
+};
+
+// UTF-8 编码，每个码点是一个字符
+// 同一个码点的多个字节与其他字节一样存储在压缩的路径中，不会为码点单独建立节点
+// 合法的 UTF-8 编码没有一个码点的编码是另一个码点的编码的前缀
+// 因此前缀查询、最长前缀等按字节进行的操作得到的结果总是完整的码点序列
+struct XSFUtf8Encoding {
+  static bool Valid(const std::string& key) {
+    size_t i = 0;
+    while (i < key.size()) {
+      uint8_t lead = static_cast<uint8_t>(key[i]);
+      size_t n = SymbolLength(lead);
+      if (n == 0 || key.size() - i < n) {
+        return false;
+      }
+      uint32_t cp = n == 1 ? lead : lead & (0x7F >> n);
+      for (size_t j = 1; j < n; j++) {
+        uint8_t b = static_cast<uint8_t>(key[i + j]);
+        if ((b & 0xC0) != 0x80) {
+          return false;
+        }
+        cp = (cp << 6) | (b & 0x3F);
+      }
+      // 拒绝过长编码、代理项和超出 Unicode 范围的码点
+      static constexpr uint32_t kMin[5]{0, 0, 0x80, 0x800, 0x10000};
+      if (cp < kMin[n] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+        return false;
+      }
+      i += n;
+    }
+    return true;
+  }
+
+  // lead 不是合法的首字节时返回 0
+  static size_t SymbolLength(uint8_t lead) {
+    if (lead < 0x80) {
+      return 1;
+    }
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      return 2;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF) {
+      return 3;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4) {
+      return 4;
+    }
+    return 0;
+  }
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_TRIE_ALPHABET_H
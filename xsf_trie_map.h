@@ -1,28 +1,72 @@
 #ifndef XSF_TRIE_MAP_H
 #define XSF_TRIE_MAP_H
 
+#include <bit>
+#include <cstdint>
 #include <list>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "xsf_trie_alphabet.h"
 
 namespace xsf_data_structures {
 
-template <typename V>
+// Alphabet 为字母表策略（见 xsf_trie_alphabet.h），默认按无符号字节处理
+// 插入含有字母表以外字符的键时抛出异常，查询这样的键时视为不存在
+template <typename V, class Alphabet = XSFByteAlphabet>
 class XSFTrieMap {
  private:
-  static const unsigned short kASCIICodeCount_{256};
+  static constexpr size_t kAlphabetSize_{Alphabet::kSize};
+  static constexpr size_t kBitWords_{(kAlphabetSize_ + 63) / 64};
   // TrieNode 节点本身只存储 value 字段，并没有一个字段来存储字符
   // 字符是通过节点在父节点的 children 数组中的索引确定的
   struct Node {
     V* value{nullptr};
-    // children['a'] 代表指向字符 'a' 的子节点的指针
-    Node* children[kASCIICodeCount_];
+    // children[Alphabet::ToIndex('a')] 代表指向字符 'a' 的子节点的指针
+    Node* children[kAlphabetSize_];
+    // 子节点位图，第 c 位为 1 表示 children[c] 不为空，遍历时据此跳过空的子节点
+    uint64_t child_bits[kBitWords_]{};
 
     Node() {
-      for (size_t i = 0; i < kASCIICodeCount_; ++i) {
+      for (size_t i = 0; i < kAlphabetSize_; ++i) {
         children[i] = nullptr;
       }
     }
+
+    // 设置 children[c]，同时维护位图
+    void SetChild(size_t c, Node* child) {
+      children[c] = child;
+      if (child != nullptr) {
+        child_bits[c / 64] |= uint64_t(1) << (c % 64);
+      } else {
+        child_bits[c / 64] &= ~(uint64_t(1) << (c % 64));
+      }
+    }
+
+    // 返回索引不小于 from 的第一个非空子节点的索引，不存在时返回 kAlphabetSize_
+    size_t NextChild(size_t from) const {
+      for (size_t w = from / 64; w < kBitWords_; ++w) {
+        uint64_t bits = child_bits[w];
+        if (w == from / 64) {
+          bits &= ~uint64_t(0) << (from % 64);
+        }
+        if (bits != 0) {
+          return w * 64 + std::countr_zero(bits);
+        }
+      }
+      return kAlphabetSize_;
+    }
+
+    bool HasChildren() const {
+      for (uint64_t bits : child_bits) {
+        if (bits != 0) {
+          return true;
+        }
+      }
+      return false;
+    }
   };
 
  public:
@@ -32,12 +76,14 @@ class XSFTrieMap {
 
   // 增、改
   V& operator[](const std::string& key) {
+    CheckKey(key);
     auto [node, value] = InsertNodes(root_, key, 0);
     root_ = node;
     return value;
   }
 
   V& operator[](std::string&& key) {
+    CheckKey(key);
     auto [node, value] = InsertNodes(root_, std::forward<std::string>(key), 0);
     root_ = node;
     return value;
@@ -89,8 +135,7 @@ class XSFTrieMap {
         return query.substr(0, i);
       }
       // 继续向下搜索
-      char c = query[i];
-      node = node->children[c];
+      node = Child(node, query[i]);
     }
     if (node != nullptr && node->value != nullptr) {
       // 如果 query 本身就是一个键，返回 query
@@ -112,8 +157,7 @@ class XSFTrieMap {
         return query.substr(0, i);
       }
       // 继续向下搜索
-      char c = query[i];
-      node = node->children[c];
+      node = Child(node, query[i]);
     }
     if (node != nullptr && node->value != nullptr) {
       // 如果 query 本身就是一个键，返回 query
@@ -138,8 +182,7 @@ class XSFTrieMap {
         max_length = i;
       }
       // 继续向下搜索
-      char c = query[i];
-      node = node->children[c];
+      node = Child(node, query[i]);
     }
     if (node != nullptr && node->value != nullptr) {
       // 如果 query 本身就是一个键，返回 query
@@ -163,8 +206,7 @@ class XSFTrieMap {
         max_length = i;
       }
       // 继续向下搜索
-      char c = query[i];
-      node = node->children[c];
+      node = Child(node, query[i]);
     }
     if (node != nullptr && node->value != nullptr) {
       // 如果 query 本身就是一个键，返回 query
@@ -235,12 +277,147 @@ class XSFTrieMap {
     return Match(root_, std::forward<std::string>(pattern), 0);
   }
 
+  // 按字典序对前缀为 prefix 的键值对调用 visitor(key, value)，最多调用 limit 次
+  // 与 FindKeysWithPrefix 相比不使用递归，也不为每个结果分配内存
+  // 所有结果共用同一个路径缓冲区，key 只在本次调用 visitor 期间有效
+  // 返回调用 visitor 的次数
+  template <typename Visitor>
+  size_t VisitKeysWithPrefix(const std::string& prefix, Visitor&& visitor,
+                             size_t limit = SIZE_MAX) const {
+    Node* node = FindNode(root_, prefix, 0);
+    if (node == nullptr || limit == 0) {
+      return 0;
+    }
+    size_t count = 0;
+    std::string path = prefix;
+    if (node->value != nullptr) {
+      visitor(static_cast<const std::string&>(path),
+              static_cast<const V&>(*node->value));
+      if (++count == limit) {
+        return count;
+      }
+    }
+    // 显式栈，每一层记录节点和下一个待访问的子节点索引
+    std::vector<std::pair<Node*, size_t>> stack;
+    stack.emplace_back(node, 0);
+    while (!stack.empty()) {
+      auto& [parent, next] = stack.back();
+      size_t c = parent->NextChild(next);
+      if (c == kAlphabetSize_) {
+        // parent 的子节点已全部访问，回溯
+        stack.pop_back();
+        if (!stack.empty()) {
+          path.pop_back();
+        }
+        continue;
+      }
+      next = c + 1;
+      Node* child = parent->children[c];
+      path.push_back(Alphabet::ToChar(c));
+      if (child->value != nullptr) {
+        visitor(static_cast<const std::string&>(path),
+                static_cast<const V&>(*child->value));
+        if (++count == limit) {
+          return count;
+        }
+      }
+      stack.emplace_back(child, 0);
+    }
+    return count;
+  }
+
+  // 按字典序对符合 pattern 的键值对调用 visitor(key, value)（通配符 . 匹配任意字符）
+  // 最多调用 limit 次，返回调用 visitor 的次数，其他同 VisitKeysWithPrefix
+  template <typename Visitor>
+  size_t VisitKeysWithPattern(const std::string& pattern, Visitor&& visitor,
+                              size_t limit = SIZE_MAX) const {
+    if (root_ == nullptr || limit == 0) {
+      return 0;
+    }
+    if (pattern.empty()) {
+      if (root_->value == nullptr) {
+        return 0;
+      }
+      visitor(static_cast<const std::string&>(pattern),
+              static_cast<const V&>(*root_->value));
+      return 1;
+    }
+    size_t count = 0;
+    std::string path;
+    // 栈的深度即已匹配的字符个数，栈顶节点对应 pattern[0..stack.size() - 1)
+    std::vector<std::pair<Node*, size_t>> stack;
+    stack.emplace_back(root_, 0);
+    while (!stack.empty()) {
+      auto& [parent, next] = stack.back();
+      char p = pattern[stack.size() - 1];
+      size_t c;
+      if (p == '.') {
+        // 通配符，借助位图只访问非空的子节点
+        c = parent->NextChild(next);
+      } else {
+        c = Alphabet::ToIndex(p);
+        if (c == kAlphabetSize_ || next > c || parent->children[c] == nullptr) {
+          c = kAlphabetSize_;
+        }
+      }
+      if (c == kAlphabetSize_) {
+        stack.pop_back();
+        if (!stack.empty()) {
+          path.pop_back();
+        }
+        continue;
+      }
+      next = c + 1;
+      Node* child = parent->children[c];
+      path.push_back(Alphabet::ToChar(c));
+      if (stack.size() == pattern.size()) {
+        // pattern 匹配完成，child 不必入栈
+        if (child->value != nullptr) {
+          visitor(static_cast<const std::string&>(path),
+                  static_cast<const V&>(*child->value));
+          if (++count == limit) {
+            return count;
+          }
+        }
+        path.pop_back();
+      } else {
+        stack.emplace_back(child, 0);
+      }
+    }
+    return count;
+  }
+
+  // 按字典序（逐字节从小到大）对每个键值对调用 visitor(key, value)
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const {
+    std::string path;
+    ForEach(root_, path, visitor);
+  }
+
   // 工具函数
   size_t Size() const { return size_; }
 
   bool Empty() const { return size_ == 0; }
 
+  // 估算占用的内存字节数，包括节点和 value
+  size_t MemoryUsage() const { return sizeof(*this) + MemoryUsage(root_); }
+
  private:
+  // key 含有字母表以外的字符时抛出异常
+  void CheckKey(const std::string& key) const {
+    for (char c : key) {
+      if (Alphabet::ToIndex(c) == kAlphabetSize_) {
+        throw std::invalid_argument("key contains character outside alphabet");
+      }
+    }
+  }
+
+  // 返回 node 中字符 c 对应的子节点，c 不属于字母表时返回 null
+  Node* Child(Node* node, char c) const {
+    size_t i = Alphabet::ToIndex(c);
+    return i == kAlphabetSize_ ? nullptr : node->children[i];
+  }
+
   // 向以 node 为根的 Trie 树中插入 key[i..]
   // 返回插入后的根节点、新节点的 value 的引用
   std::pair<Node*, V&> InsertNodes(Node* node, const std::string& key,
@@ -258,11 +435,11 @@ class XSFTrieMap {
       }
       return {node, *(node->value)};
     }
-    char c = key[i];
+    size_t c = Alphabet::ToIndex(key[i]);
     // 在 node 的 children 数组中“插入字符 c”
     // 递归地从 node->children[c] 开始插入 key[i+1..]
     auto [child, value] = InsertNodes(node->children[c], key, i + 1);
-    node->children[c] = child;
+    node->SetChild(c, child);
     return {node, value};
   }
 
@@ -280,12 +457,12 @@ class XSFTrieMap {
       }
       return {node, *(node->value)};
     }
-    char c = key[i];
+    size_t c = Alphabet::ToIndex(key[i]);
     // 在 node 的 children 数组中“插入字符 c”
     // 递归地从 node->children[c] 开始插入 key[i+1..]
     auto [child, value] =
         InsertNodes(node->children[c], std::forward<std::string>(key), i + 1);
-    node->children[c] = child;
+    node->SetChild(c, child);
     return {node, value};
   }
 
@@ -298,9 +475,9 @@ class XSFTrieMap {
       delete node->value;
       node->value = nullptr;
     } else {
-      char c = key[i];
+      size_t c = Alphabet::ToIndex(key[i]);
       // 递归地从 node->children[c] 开始删除 key[i+1..]
-      node->children[c] = Erase(node->children[c], key, i + 1);
+      node->SetChild(c, Erase(node->children[c], key, i + 1));
     }
 
     // 后序位置，递归路径上的节点可能需要被清理
@@ -309,11 +486,9 @@ class XSFTrieMap {
       return node;
     }
     // 检查该 TrieNode 是否还有后缀
-    for (size_t i = 0; i < kASCIICodeCount_; ++i) {
-      if (node->children[i] != nullptr) {
-        // 只要存在一个子节点（后缀树枝），就不需要被清理
-        return node;
-      }
+    if (node->HasChildren()) {
+      // 只要存在一个子节点（后缀树枝），就不需要被清理
+      return node;
     }
     // 既没有存储 val，也没有后缀树枝，则该节点需要被清理
     delete node;
@@ -327,10 +502,10 @@ class XSFTrieMap {
       delete node->value;
       node->value = nullptr;
     } else {
-      char c = key[i];
+      size_t c = Alphabet::ToIndex(key[i]);
       // 递归地从 node->children[c] 开始删除 key[i+1..]
-      node->children[c] =
-          Erase(node->children[c], std::forward<std::string>(key), i + 1);
+      node->SetChild(
+          c, Erase(node->children[c], std::forward<std::string>(key), i + 1));
     }
 
     // 后序位置，递归路径上的节点可能需要被清理
@@ -339,11 +514,9 @@ class XSFTrieMap {
       return node;
     }
     // 检查该 TrieNode 是否还有后缀
-    for (size_t i = 0; i < kASCIICodeCount_; ++i) {
-      if (node->children[i] != nullptr) {
-        // 只要存在一个子节点（后缀树枝），就不需要被清理
-        return node;
-      }
+    if (node->HasChildren()) {
+      // 只要存在一个子节点（后缀树枝），就不需要被清理
+      return node;
     }
     // 既没有存储 val，也没有后缀树枝，则该节点需要被清理
     delete node;
@@ -355,11 +528,12 @@ class XSFTrieMap {
     if (node == nullptr) {
       return;
     }
-    for (size_t i = 0; i < kASCIICodeCount_; ++i) {
+    for (size_t i = 0; i < kAlphabetSize_; ++i) {
       if (node->children[i] != nullptr) {
         Clear(node->children[i]);
       }
     }
+    delete node->value;
     delete node;
   }
 
@@ -371,8 +545,7 @@ class XSFTrieMap {
     if (i == key.size()) {
       return node;
     }
-    char c = key[i];
-    return FindNode(node->children[c], key, i + 1);
+    return FindNode(Child(node, key[i]), key, i + 1);
   }
 
   Node* FindNode(Node* node, std::string&& key, size_t i) const {
@@ -382,8 +555,7 @@ class XSFTrieMap {
     if (i == key.size()) {
       return node;
     }
-    char c = key[i];
-    return FindNode(node->children[c], std::forward<std::string>(key), i + 1);
+    return FindNode(Child(node, key[i]), std::forward<std::string>(key), i + 1);
   }
 
   // 遍历以 node 节点为根的 Trie 树，找到所有键
@@ -399,10 +571,10 @@ class XSFTrieMap {
     }
 
     // 回溯算法遍历框架
-    for (size_t i = 0; i < kASCIICodeCount_; ++i) {
+    for (size_t i = 0; i < kAlphabetSize_; ++i) {
       if (node->children[i] != nullptr) {
         // 做选择：仅当 children[i] 不为空时才添加字符到 path 末尾
-        path.push_back(i);
+        path.push_back(Alphabet::ToChar(i));
         // 递归地遍历 children[i]
         Traverse(node->children[i], path, keys);
         // 撤销选择：回溯时删除 path 末尾的字符
@@ -411,6 +583,25 @@ class XSFTrieMap {
     }
   }
 
+  // 遍历以 node 节点为根的 Trie 树，对每个键值对调用 visitor
+  template <typename Visitor>
+  void ForEach(Node* node, std::string& path, Visitor& visitor) const {
+    if (node == nullptr) {
+      return;
+    }
+    if (node->value != nullptr) {
+      visitor(static_cast<const std::string&>(path),
+              static_cast<const V&>(*node->value));
+    }
+    for (size_t i = 0; i < kAlphabetSize_; ++i) {
+      if (node->children[i] != nullptr) {
+        path.push_back(Alphabet::ToChar(i));
+        ForEach(node->children[i], path, visitor);
+        path.pop_back();
+      }
+    }
+  }
+
   // 遍历函数，尝试在「以 node 为根的 Trie 树中」匹配 pattern[i..]
   void Traverse(Node* node, std::string& path, const std::string& pattern,
                 size_t i, std::list<std::string>& keys) const {
@@ -426,14 +617,13 @@ class XSFTrieMap {
       }
       return;
     }
-    char c = pattern[i];
-    if (c == '.') {
+    if (pattern[i] == '.') {
       // pattern[i] 是通配符，可以变化成任意字符
       // 多叉树（回溯算法）遍历框架
-      for (size_t j = 0; j < kASCIICodeCount_; ++j) {
+      for (size_t j = 0; j < kAlphabetSize_; ++j) {
         if (node->children[j] != nullptr) {
           // 做选择
-          path.push_back(j);
+          path.push_back(Alphabet::ToChar(j));
           // 递归地遍历 children[j]
           Traverse(node->children[j], path, pattern, i + 1, keys);
           // 撤销选择
@@ -441,12 +631,13 @@ class XSFTrieMap {
         }
       }
     } else {
-      // pattern[i] 是普通字符 c
-      if (node->children[c] != nullptr) {
+      // pattern[i] 是普通字符
+      Node* child = Child(node, pattern[i]);
+      if (child != nullptr) {
         // 做选择
-        path.push_back(c);
-        // 递归地遍历 children[c]
-        Traverse(node->children[c], path, pattern, i + 1, keys);
+        path.push_back(pattern[i]);
+        // 递归地遍历 child
+        Traverse(child, path, pattern, i + 1, keys);
         // 撤销选择
         path.pop_back();
       }
@@ -467,14 +658,13 @@ class XSFTrieMap {
       }
       return;
     }
-    char c = pattern[i];
-    if (c == '.') {
+    if (pattern[i] == '.') {
       // pattern[i] 是通配符，可以变化成任意字符
       // 多叉树（回溯算法）遍历框架
-      for (size_t j = 0; j < kASCIICodeCount_; ++j) {
+      for (size_t j = 0; j < kAlphabetSize_; ++j) {
         if (node->children[j] != nullptr) {
           // 做选择
-          path.push_back(j);
+          path.push_back(Alphabet::ToChar(j));
           // 递归地遍历 children[j]
           Traverse(node->children[j], path, std::forward<std::string>(pattern),
                    i + 1, keys);
@@ -483,13 +673,13 @@ class XSFTrieMap {
         }
       }
     } else {
-      // pattern[i] 是普通字符 c
-      if (node->children[c] != nullptr) {
+      // pattern[i] 是普通字符
+      Node* child = Child(node, pattern[i]);
+      if (child != nullptr) {
         // 做选择
-        path.push_back(c);
-        // 递归地遍历 children[c]
-        Traverse(node->children[c], path, std::forward<std::string>(pattern),
-                 i + 1, keys);
+        path.push_back(pattern[i]);
+        // 递归地遍历 child
+        Traverse(child, path, std::forward<std::string>(pattern), i + 1, keys);
         // 撤销选择
         path.pop_back();
       }
@@ -506,15 +696,14 @@ class XSFTrieMap {
       // 模式串走到头了，看看匹配到的是否是一个键
       return node->value != nullptr;
     }
-    char c = pattern[i];
-    if (c != '.') {
+    if (pattern[i] != '.') {
       // 没有遇到通配符
-      // 从 node.children[c] 节点开始匹配 pattern[i+1..]
-      return Match(node->children[c], pattern, i + 1);
+      // 从 pattern[i] 对应的子节点开始匹配 pattern[i+1..]
+      return Match(Child(node, pattern[i]), pattern, i + 1);
     } else {
       // 遇到通配符
       // pattern[i] 可以变化成任意字符，尝试所有可能，只要遇到一个匹配成功就返回
-      for (size_t j = 0; j < kASCIICodeCount_; ++j) {
+      for (size_t j = 0; j < kAlphabetSize_; ++j) {
         if (Match(node->children[j], pattern, i + 1)) {
           return true;
         }
@@ -533,16 +722,15 @@ class XSFTrieMap {
       // 模式串走到头了，看看匹配到的是否是一个键
       return node->value != nullptr;
     }
-    char c = pattern[i];
-    if (c != '.') {
+    if (pattern[i] != '.') {
       // 没有遇到通配符
-      // 从 node.children[c] 节点开始匹配 pattern[i+1..]
-      return Match(node->children[c], std::forward<std::string>(pattern),
+      // 从 pattern[i] 对应的子节点开始匹配 pattern[i+1..]
+      return Match(Child(node, pattern[i]), std::forward<std::string>(pattern),
                    i + 1);
     } else {
       // 遇到通配符
       // pattern[i] 可以变化成任意字符，尝试所有可能，只要遇到一个匹配成功就返回
-      for (size_t j = 0; j < kASCIICodeCount_; ++j) {
+      for (size_t j = 0; j < kAlphabetSize_; ++j) {
         if (Match(node->children[j], std::forward<std::string>(pattern),
                   i + 1)) {
           return true;
@@ -553,6 +741,20 @@ class XSFTrieMap {
     }
   }
 
+  size_t MemoryUsage(Node* node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    size_t bytes = sizeof(Node);
+    if (node->value != nullptr) {
+      bytes += sizeof(V);
+    }
+    for (size_t i = 0; i < kAlphabetSize_; ++i) {
+      bytes += MemoryUsage(node->children[i]);
+    }
+    return bytes;
+  }
+
   size_t size_{0};
   Node* root_{nullptr};
 };
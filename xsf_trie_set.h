@@ -94,6 +94,14 @@ class XSFTrieSet {
     return map_.ContainsKeysWithPattern(std::forward<std::string>(pattern));
   }
 
+  // 按字典序对集合中的每个元素调用 visitor(key)
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) const {
+    map_.ForEach([&visitor](const std::string& key, const char&) {
+      visitor(key);
+    });
+  }
+
   // 工具函数
   size_t Size() const { return map_.Size(); }
 
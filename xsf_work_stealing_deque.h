@@ -0,0 +1,183 @@
+#ifndef XSF_WORK_STEALING_DEQUE_H
+#define XSF_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace xsf_data_structures {
+
+// 并发工作窃取双端队列（Chase-Lev），与 XSFArrayDeque 一样基于环形数组
+// 只有拥有者线程可以调用 Push、Pop，在队尾操作
+// 任意线程都可以调用 Steal，在队头窃取
+// 元素通过原子变量读写，因此 T 必须是可平凡复制的（通常是任务指针）
+template <typename T>
+class XSFWorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "T must be trivially copyable");
+
+ private:
+  // 容量为 2 的指数的环形数组
+  struct Array {
+    size_t capacity;
+    size_t mask;
+    std::atomic<T>* data;
+
+    explicit Array(size_t c)
+        : capacity(c), mask(c - 1), data(new std::atomic<T>[c]) {}
+
+    ~Array() { delete[] data; }
+
+    T Get(int64_t i) const {
+      return data[i & mask].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t i, T value) {
+      data[i & mask].store(value, std::memory_order_relaxed);
+    }
+
+    // 返回容量翻倍的新数组，包含索引区间 [top, bottom) 中的元素
+    Array* Grow(int64_t top, int64_t bottom) const {
+      Array* array = new Array(capacity * 2);
+      for (int64_t i = top; i < bottom; i++) {
+        array->Put(i, Get(i));
+      }
+      return array;
+    }
+  };
+
+ public:
+  XSFWorkStealingDeque(size_t capacity = 64) {
+    array_.store(new Array(CeilToPow2(capacity)), std::memory_order_relaxed);
+  }
+
+  XSFWorkStealingDeque(const XSFWorkStealingDeque&) = delete;
+  XSFWorkStealingDeque& operator=(const XSFWorkStealingDeque&) = delete;
+
+  ~XSFWorkStealingDeque() {
+    delete array_.load(std::memory_order_relaxed);
+    for (Array* array : garbage_) {
+      delete array;
+    }
+  }
+
+  // 增，仅限拥有者线程
+  void Push(T value) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(array->capacity) - 1) {
+      // 扩容
+      // 窃取者可能仍在读旧数组，旧数组延迟到析构时再释放
+      Array* new_array = array->Grow(t, b);
+      garbage_.push_back(array);
+      array = new_array;
+      array_.store(array, std::memory_order_release);
+    }
+    array->Put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  // 删，仅限拥有者线程，从队尾弹出元素到 out 中，队列为空时返回 false
+  bool Pop(T& out) {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    // 先预留队尾元素，再检查是否与窃取者冲突
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {
+      // 队列为空，恢复 bottom_
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    T value = array->Get(b);
+    if (t < b) {
+      // 队列中还有其他元素，不会与窃取者冲突
+      out = value;
+      return true;
+    }
+
+    // 只剩最后一个元素，需要与窃取者竞争
+    bool won = top_.compare_exchange_strong(t, t + 1,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    if (won) {
+      out = value;
+    }
+    return won;
+  }
+
+  // 任意线程，从队头窃取元素到 out 中
+  // 队列为空或与其他线程竞争失败时返回 false
+  bool Steal(T& out) {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return false;
+    }
+
+    Array* array = array_.load(std::memory_order_acquire);
+    T value = array->Get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    out = value;
+    return true;
+  }
+
+  // 工具函数，并发情况下只是一个近似值
+  size_t Size() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  bool Empty() const { return Size() == 0; }
+
+ private:
+  // 将输入的 n 转化为 2 的指数，比如输入 12，返回 16
+  size_t CeilToPow2(size_t n) {
+    // size_t 型最大值为 2^64 - 1
+    // 所以无法向上取整到 2^64
+    if (n > 0x8000000000000000) {
+      return 0x8000000000000000;
+    }
+    if (n < 2) {
+      return 2;
+    }
+
+    // 位运算技巧，参考如下链接：
+    // http://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    n |= n >> 32;
+    n++;
+
+    return n;
+  }
+
+  // top_、bottom_ 分别位于独立的缓存行，避免拥有者与窃取者伪共享
+  // 索引区间 [top_, bottom_) 存储着队列中的元素
+  alignas(64) std::atomic<int64_t> top_{0};     // 窃取者操作的队头
+  alignas(64) std::atomic<int64_t> bottom_{0};  // 拥有者操作的队尾
+  alignas(64) std::atomic<Array*> array_{nullptr};
+
+  // 扩容后被替换的旧数组，仅由拥有者线程访问
+  std::vector<Array*> garbage_;
+};
+
+}  // namespace xsf_data_structures
+
+#endif  // XSF_WORK_STEALING_DEQUE_H